@@ -0,0 +1,233 @@
+#include "graph_core/GraphGenerator.hpp"
+#include "graph_core/GraphStorage.hpp"
+#include "graph_core/CsrGraph.hpp"
+#include "graph_core/algorithms.hpp"
+#include "graph_core/VertexOrder.hpp"
+#include "api/GraphAPI.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <string>
+
+// Todas las pruebas usan grafos Erdős–Rényi con semilla fija, así que dos ejecuciones
+// (o dos commits) miden exactamente los mismos grafos. Argumentos: {nodos, densidad},
+// con la densidad en milésimas de probabilidad de arista.
+
+namespace
+{
+    constexpr std::uint64_t seed = 42;
+
+    double edgeProbability(const benchmark::State& state) {
+        return static_cast<double>(state.range(1)) / 1000.0;
+    }
+
+    // Almacenamiento de los grafos generados
+    struct ListStorage {
+        template <typename T>
+        static AdjacencyListGraph<T> generate(std::size_t n, double p) {
+            return GraphGenerator::generateAdjacencyListGraph<T>(n, p, T{1}, T{100}, true, seed, 1);
+        }
+        template <typename T>
+        static AdjacencyListGraph<T> deserialize(const nlohmann::json& j) {
+            return GraphAPI::deserializeList<T>(j);
+        }
+        template <typename T>
+        static std::size_t edges(const AdjacencyListGraph<T>& g) { return CsrGraph<T>(g).edgeCount(); }
+    };
+
+    struct MatrixStorage {
+        template <typename T>
+        static AdjacencyMatrixGraph<T> generate(std::size_t n, double p) {
+            return GraphGenerator::generateAdjacencyMatrixGraph<T>(n, p, T{1}, T{100}, true, seed, 1);
+        }
+        template <typename T>
+        static AdjacencyMatrixGraph<T> deserialize(const nlohmann::json& j) {
+            return GraphAPI::deserializeMatrix<T>(j);
+        }
+        template <typename T>
+        static std::size_t edges(const AdjacencyMatrixGraph<T>& g) { return g.edgeCount(); }
+    };
+
+    // Grafo de lista sobre el que corren los algoritmos, en su forma original o ya en CSR
+    template <typename T, bool Csr>
+    auto algorithmInput(const benchmark::State& state) {
+        auto graph = ListStorage::generate<T>(static_cast<std::size_t>(state.range(0)), edgeProbability(state));
+        if constexpr (Csr)
+            return CsrGraph<T>(graph);
+        else
+            return graph;
+    }
+
+    void edgeCounters(benchmark::State& state, std::size_t edges) {
+        state.counters["edges"] = static_cast<double>(edges);
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * edges));
+    }
+}
+
+// ---------- Generador ----------
+
+template <typename Storage, typename T>
+static void BM_Generate(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        auto graph = Storage::template generate<T>(n, edgeProbability(state));
+        benchmark::DoNotOptimize(graph);
+    }
+    edgeCounters(state, Storage::edges(Storage::template generate<T>(n, edgeProbability(state))));
+}
+
+// ---------- Algoritmos ----------
+// Sobre AdjacencyListGraph el tiempo incluye construir la CSR, como en una llamada
+// directa; con Csr = true la CSR ya está construida.
+
+template <typename T, bool Csr>
+static void BM_BFS(benchmark::State& state) {
+    const auto graph = algorithmInput<T, Csr>(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Algorithms::BFS(graph, 0));
+    edgeCounters(state, CsrGraph<T>(graph).edgeCount());
+}
+
+template <typename T, bool Csr>
+static void BM_DFS(benchmark::State& state) {
+    const auto graph = algorithmInput<T, Csr>(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Algorithms::DFS(graph, 0));
+    edgeCounters(state, CsrGraph<T>(graph).edgeCount());
+}
+
+template <typename T, bool Csr>
+static void BM_Dijkstra(benchmark::State& state) {
+    const auto graph = algorithmInput<T, Csr>(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Algorithms::Dijkstra(graph, 0));
+    edgeCounters(state, CsrGraph<T>(graph).edgeCount());
+}
+
+// Camino hasta el nodo alcanzable más lejano (en saltos) del árbol de Dijkstra
+template <typename T>
+static void BM_ReconstructPath(benchmark::State& state) {
+    const auto graph = algorithmInput<T, true>(state);
+    const auto r = Algorithms::Dijkstra(graph, 0);
+    int target = 0;
+    std::size_t longest = 0;
+    for (const auto& [id, parent] : r.parent) {
+        const std::size_t length = Algorithms::ReconstructPath<T>(id, r.parent).size();
+        if (parent != -1 && length > longest) {
+            longest = length;
+            target = id;
+        }
+    }
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Algorithms::ReconstructPath<T>(target, r.parent));
+    state.counters["path_length"] = static_cast<double>(longest);
+}
+
+// ---------- Orden de los vértices ----------
+// Coste de calcular el orden y aplicarlo, y BFS / Dijkstra sobre la CSR reordenada,
+// para comparar con BM_BFS / BM_Dijkstra con Csr = true.
+
+template <VertexOrder Order>
+static void BM_Reorder(benchmark::State& state) {
+    const auto graph = algorithmInput<int, true>(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Algorithms::Reorder(graph, Order));
+    edgeCounters(state, graph.edgeCount());
+}
+
+template <VertexOrder Order>
+static void BM_BFSReordered(benchmark::State& state) {
+    const auto graph = Algorithms::Reorder(algorithmInput<int, true>(state), Order);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Algorithms::BFS(graph, 0));
+    edgeCounters(state, graph.edgeCount());
+}
+
+template <VertexOrder Order>
+static void BM_DijkstraReordered(benchmark::State& state) {
+    const auto graph = Algorithms::Reorder(algorithmInput<int, true>(state), Order);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Algorithms::Dijkstra(graph, 0));
+    edgeCounters(state, graph.edgeCount());
+}
+
+// ---------- Serialización ----------
+
+// serialize() y volcado a texto, como en la respuesta de /get_graph
+template <typename Storage, typename T>
+static void BM_Serialize(benchmark::State& state) {
+    const auto graph = Storage::template generate<T>(static_cast<std::size_t>(state.range(0)), edgeProbability(state));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::string text = GraphAPI::serialize(graph).dump();
+        bytes = text.size();
+        benchmark::DoNotOptimize(text);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+    edgeCounters(state, Storage::edges(graph));
+}
+
+// Análisis del texto y deserialize*(), como en /add_graph
+template <typename Storage, typename T>
+static void BM_Deserialize(benchmark::State& state) {
+    const auto graph = Storage::template generate<T>(static_cast<std::size_t>(state.range(0)), edgeProbability(state));
+    const std::string text = GraphAPI::serialize(graph).dump();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Storage::template deserialize<T>(nlohmann::json::parse(text)));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * text.size()));
+    edgeCounters(state, Storage::edges(graph));
+}
+
+// Ida y vuelta completa: grafo -> texto -> grafo
+template <typename Storage, typename T>
+static void BM_RoundTrip(benchmark::State& state) {
+    const auto graph = Storage::template generate<T>(static_cast<std::size_t>(state.range(0)), edgeProbability(state));
+    for (auto _ : state) {
+        auto copy = Storage::template deserialize<T>(nlohmann::json::parse(GraphAPI::serialize(graph).dump()));
+        benchmark::DoNotOptimize(copy);
+    }
+    edgeCounters(state, Storage::edges(graph));
+}
+
+// ---------- Registro ----------
+// Nodos x densidad (0,2 %, 2 % y 10 %). Las matrices ocupan n^2, así que se
+// quedan en tamaños menores.
+
+#define GRAPH_LIST_ARGS ArgsProduct({{256, 1024, 4096}, {2, 20, 100}})
+#define GRAPH_MATRIX_ARGS ArgsProduct({{256, 1024, 2048}, {2, 20, 100}})
+
+BENCHMARK_TEMPLATE(BM_Generate, ListStorage, int)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Generate, ListStorage, double)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Generate, MatrixStorage, int)->GRAPH_MATRIX_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Generate, MatrixStorage, double)->GRAPH_MATRIX_ARGS->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_BFS, int, false)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BFS, int, true)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DFS, int, false)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DFS, int, true)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Dijkstra, int, false)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Dijkstra, int, true)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Dijkstra, double, false)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Dijkstra, double, true)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ReconstructPath, int)->GRAPH_LIST_ARGS;
+
+BENCHMARK_TEMPLATE(BM_Reorder, VertexOrder::Degree)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Reorder, VertexOrder::Rcm)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Reorder, VertexOrder::Rabbit)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BFSReordered, VertexOrder::Degree)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BFSReordered, VertexOrder::Rcm)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BFSReordered, VertexOrder::Rabbit)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DijkstraReordered, VertexOrder::Degree)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DijkstraReordered, VertexOrder::Rcm)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DijkstraReordered, VertexOrder::Rabbit)->GRAPH_LIST_ARGS->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_Serialize, ListStorage, int)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Serialize, ListStorage, double)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Serialize, MatrixStorage, int)->GRAPH_MATRIX_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Deserialize, ListStorage, int)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Deserialize, ListStorage, double)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Deserialize, MatrixStorage, int)->GRAPH_MATRIX_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RoundTrip, ListStorage, int)->GRAPH_LIST_ARGS->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RoundTrip, MatrixStorage, int)->GRAPH_MATRIX_ARGS->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -1,15 +1,35 @@
 #pragma once
 #include "graph_core/GraphStorage.hpp"
 #include "graph_core/algorithms.hpp"
+#include "graph_core/VertexIndex.hpp"
+#include "graph_core/Trace.hpp"
+#include "graph_core/ShortestPath.hpp"
+#include "graph_core/FloydWarshall.hpp"
+#include "graph_core/MultiSourceBFS.hpp"
+#include "graph_core/ConnectedComponents.hpp"
+#include "graph_core/Centrality.hpp"
+#include "graph_repository/GraphFile.hpp"
+#include "api/JsonWriter.hpp"
+#include "api/MetricsMiddleware.hpp"
 #include <nlohmann/json.hpp>
 #include <crow.h>
+#include <algorithm>
+#include <limits>
+#include <memory>
 
 /**
  * @brief Provides JSON serialization and deserialization for different graph representations.
  */
 class GraphAPI {
 public:
-    static void registerEndpoints(crow::SimpleApp& app);
+    // Crow app with request timing for /metrics.
+    using App = crow::App<MetricsMiddleware>;
+
+    static void registerEndpoints(App& app);
+
+    // Map / write the graphs of GRAPH_DATA_DIR, if set; return how many.
+    static std::size_t restoreGraphs();
+    static std::size_t persistGraphs();
 
     //
     // Adjacency List
@@ -52,6 +72,33 @@ public:
         return graph;
     }
 
+    //
+    // Mapped graph file (read-only adjacency list)
+    //
+    template<typename Weight = double>
+    static nlohmann::json serialize(const GraphFile::MappedGraph<Weight>& graph) {
+        nlohmann::json j;
+        j["type"] = "list";
+        j["directed"] = graph.isDirected();
+
+        const auto& csr = graph.csr();
+        for (std::size_t u = 0; u < csr.vertexCount(); ++u) {
+            const int from = csr.vertexId(static_cast<int>(u));
+            j["nodes"].push_back({{"id", from}, {"label", graph.label(static_cast<int>(u))}});
+
+            const auto neighbors = csr.neighbors(static_cast<int>(u));
+            const auto weights = csr.weights(static_cast<int>(u));
+            for (std::size_t k = 0; k < neighbors.size(); ++k) {
+                const int to = csr.vertexId(neighbors[k]);
+                if (graph.isDirected() || from < to) {
+                    j["edges"].push_back({{"from", from}, {"to", to}, {"weight", weights[k]}});
+                }
+            }
+        }
+
+        return j;
+    }
+
     //
     // Adjacency Matrix
     //
@@ -69,19 +116,16 @@ public:
         }
 
         // Serialize edges
-        const auto& matrix = graph.getMatrix();
-        for (size_t i = 0; i < matrix.size(); ++i) {
-            for (size_t j2 = 0; j2 < matrix[i].size(); ++j2) {
-                if (matrix[i][j2].has_value()) {
-                    if (graph.isDirected() || i < j2) {
-                        j["edges"].push_back({
-                            {"from", static_cast<int>(i)},
-                            {"to", static_cast<int>(j2)},
-                            {"weight", matrix[i][j2].value()}
-                        });
-                    }
+        for (size_t i = 0; i < graph.size(); ++i) {
+            graph.forEachNeighbor(i, [&](size_t j2, Weight weight) {
+                if (graph.isDirected() || i < j2) {
+                    j["edges"].push_back({
+                        {"from", static_cast<int>(i)},
+                        {"to", static_cast<int>(j2)},
+                        {"weight", weight}
+                    });
                 }
-            }
+            });
         }
 
         return j;
@@ -124,11 +168,14 @@ public:
         r.source = j.at("source").get<int>();
         r.order  = j.at("order").get<std::vector<int>>();
 
+        auto index = indexFromEntries(j.at("parent"), j.at("depth"));
+        r.parent = VertexMap<int>(index, -1);
+        r.depth  = VertexMap<int>(index, std::numeric_limits<int>::max());
         for (const auto& kv : j.at("parent")) {
-            r.parent[kv.at("node").get<int>()] = kv.at("parent").get<int>();
+            r.parent.at(kv.at("node").get<int>()) = kv.at("parent").get<int>();
         }
         for (const auto& kv : j.at("depth")) {
-            r.depth[kv.at("node").get<int>()] = kv.at("depth").get<int>();
+            r.depth.at(kv.at("node").get<int>()) = kv.at("depth").get<int>();
         }
         return r;
     }
@@ -154,12 +201,319 @@ public:
         DijkstraResult<Weight> r;
         r.source = j.at("source").get<int>();
 
+        auto index = indexFromEntries(j.at("dist"), j.at("parent"));
+        r.dist   = VertexMap<Weight>(index, std::numeric_limits<Weight>::max());
+        r.parent = VertexMap<int>(index, -1);
         for (const auto& kv : j.at("dist")) {
-            r.dist[kv.at("node").get<int>()] = kv.at("dist").get<Weight>();
+            r.dist.at(kv.at("node").get<int>()) = kv.at("dist").get<Weight>();
         }
         for (const auto& kv : j.at("parent")) {
-            r.parent[kv.at("node").get<int>()] = kv.at("parent").get<int>();
+            r.parent.at(kv.at("node").get<int>()) = kv.at("parent").get<int>();
         }
         return r;
     }
+
+    // --------- PathResult → JSON ---------
+    template<typename Weight = double>
+    static nlohmann::json serialize(const PathResult<Weight>& r) {
+        nlohmann::json j;
+        j["type"]   = "path";
+        j["source"] = r.source;
+        j["target"] = r.target;
+        j["found"]  = r.found;
+        if (r.found) {
+            j["cost"] = r.cost;
+        }
+        j["path"]   = r.path;
+        return j;
+    }
+
+    // --------- AllPairsResult ↔ JSON ---------
+    // dist[i][j] es null cuando no hay camino de i a j
+    template<typename Weight = double>
+    static nlohmann::json serialize(const AllPairsResult<Weight>& r) {
+        nlohmann::json j;
+        j["type"]           = "all_pairs";
+        j["size"]           = r.size;
+        j["negative_cycle"] = r.negativeCycle;
+
+        j["dist"] = nlohmann::json::array();
+        for (std::size_t i = 0; i < r.size; ++i) {
+            nlohmann::json row = nlohmann::json::array();
+            for (std::size_t k = 0; k < r.size; ++k) {
+                Weight d = r.at(i, k);
+                if (d == AllPairsResult<Weight>::infinity) row.push_back(nullptr);
+                else row.push_back(d);
+            }
+            j["dist"].push_back(std::move(row));
+        }
+        return j;
+    }
+
+    template<typename Weight = double>
+    static AllPairsResult<Weight> deserializeAllPairs(const nlohmann::json& j) {
+        AllPairsResult<Weight> r;
+        r.size          = j.at("size").get<std::size_t>();
+        r.negativeCycle = j.at("negative_cycle").get<bool>();
+        r.dist.assign(r.size * r.size, AllPairsResult<Weight>::infinity);
+        const auto& rows = j.at("dist");
+        for (std::size_t i = 0; i < r.size; ++i) {
+            for (std::size_t k = 0; k < r.size; ++k) {
+                const auto& d = rows.at(i).at(k);
+                if (!d.is_null()) r.dist[i * r.size + k] = d.get<Weight>();
+            }
+        }
+        return r;
+    }
+
+    // --------- CountingTrace → JSON ---------
+    static nlohmann::json serialize(const CountingTrace& t) {
+        nlohmann::json j;
+        j["vertices_settled"] = t.verticesSettled;
+        j["edges_relaxed"]    = t.edgesRelaxed;
+        j["heap_pushes"]      = t.heapPushes;
+        j["stale_pops"]       = t.stalePops;
+
+        j["phase_ms"] = nlohmann::json::object();
+        for (std::size_t p = 0; p < TracePhaseCount; ++p) {
+            std::chrono::duration<double, std::milli> ms = t.phaseTime[p];
+            j["phase_ms"][tracePhaseName(static_cast<TracePhase>(p))] = ms.count();
+        }
+        return j;
+    }
+
+    //
+    // Streaming output
+    //
+    // writeFields(w, x) writes the members of the object serialize(x) returns
+    // into the object currently open in w, straight to the output buffer.
+    // Callers can add their own members (e.g. "stats") before closing it.
+
+    template<typename T>
+    static void write(JsonWriter& w, const T& x) {
+        w.beginObject();
+        writeFields(w, x);
+        w.endObject();
+    }
+
+    template<typename Weight>
+    static void writeFields(JsonWriter& w, const AdjacencyListGraph<Weight>& graph) {
+        w.field("type", "list").field("directed", graph.isDirected());
+
+        w.key("nodes").beginArray();
+        for (const auto& [id, label] : graph.getNodeLabels()) {
+            w.beginObject().field("id", id).field("label", label).endObject();
+        }
+        w.endArray();
+
+        w.key("edges").beginArray();
+        for (const auto& [from, neighbors] : graph.getAdjList()) {
+            for (const auto& [to, weight] : neighbors) {
+                if (graph.isDirected() || from < to) {
+                    w.beginObject().field("from", from).field("to", to).field("weight", weight).endObject();
+                }
+            }
+        }
+        w.endArray();
+    }
+
+    template<typename Weight>
+    static void writeFields(JsonWriter& w, const GraphFile::MappedGraph<Weight>& graph) {
+        w.field("type", "list").field("directed", graph.isDirected());
+        const auto& csr = graph.csr();
+        const int n = static_cast<int>(csr.vertexCount());
+
+        w.key("nodes").beginArray();
+        for (int u = 0; u < n; ++u) {
+            w.beginObject().field("id", csr.vertexId(u)).field("label", graph.label(u)).endObject();
+        }
+        w.endArray();
+
+        w.key("edges").beginArray();
+        for (int u = 0; u < n; ++u) {
+            const int from = csr.vertexId(u);
+            const auto neighbors = csr.neighbors(u);
+            const auto weights = csr.weights(u);
+            for (std::size_t k = 0; k < neighbors.size(); ++k) {
+                const int to = csr.vertexId(neighbors[k]);
+                if (graph.isDirected() || from < to) {
+                    w.beginObject().field("from", from).field("to", to).field("weight", weights[k]).endObject();
+                }
+            }
+        }
+        w.endArray();
+    }
+
+    template<typename Weight>
+    static void writeFields(JsonWriter& w, const AdjacencyMatrixGraph<Weight>& graph) {
+        w.field("type", "matrix").field("directed", graph.isDirected()).field("size", graph.size());
+
+        const auto& labels = graph.getNodeLabels();
+        w.key("nodes").beginArray();
+        for (size_t i = 0; i < labels.size(); ++i) {
+            w.beginObject().field("id", static_cast<int>(i)).field("label", labels[i]).endObject();
+        }
+        w.endArray();
+
+        w.key("edges").beginArray();
+        for (size_t i = 0; i < graph.size(); ++i) {
+            graph.forEachNeighbor(i, [&](size_t j2, Weight weight) {
+                if (graph.isDirected() || i < j2) {
+                    w.beginObject().field("from", static_cast<int>(i)).field("to", static_cast<int>(j2))
+                        .field("weight", weight).endObject();
+                }
+            });
+        }
+        w.endArray();
+    }
+
+    static void writeFields(JsonWriter& w, const TraversalResult& r) {
+        w.field("type", "traversal").field("source", r.source);
+
+        w.key("order").beginArray();
+        for (int u : r.order) w.value(u);
+        w.endArray();
+
+        w.key("parent").beginArray();
+        for (const auto& [u, p] : r.parent) w.beginObject().field("node", u).field("parent", p).endObject();
+        w.endArray();
+
+        w.key("depth").beginArray();
+        for (const auto& [u, d] : r.depth) w.beginObject().field("node", u).field("depth", d).endObject();
+        w.endArray();
+    }
+
+    template<typename Weight>
+    static void writeFields(JsonWriter& w, const DijkstraResult<Weight>& r) {
+        w.field("type", "dijkstra").field("source", r.source);
+
+        w.key("dist").beginArray();
+        for (const auto& [u, d] : r.dist) w.beginObject().field("node", u).field("dist", d).endObject();
+        w.endArray();
+
+        w.key("parent").beginArray();
+        for (const auto& [u, p] : r.parent) w.beginObject().field("node", u).field("parent", p).endObject();
+        w.endArray();
+    }
+
+    template<typename Weight>
+    static void writeFields(JsonWriter& w, const PathResult<Weight>& r) {
+        w.field("type", "path").field("source", r.source).field("target", r.target).field("found", r.found);
+        if (r.found) {
+            w.field("cost", r.cost);
+        }
+        w.key("path").beginArray();
+        for (int u : r.path) w.value(u);
+        w.endArray();
+    }
+
+    // dist[i][j] es null cuando no hay camino de i a j
+    template<typename Weight>
+    static void writeFields(JsonWriter& w, const AllPairsResult<Weight>& r) {
+        w.field("type", "all_pairs").field("size", r.size).field("negative_cycle", r.negativeCycle);
+
+        w.key("dist").beginArray();
+        for (std::size_t i = 0; i < r.size; ++i) {
+            w.beginArray();
+            for (std::size_t k = 0; k < r.size; ++k) {
+                Weight d = r.at(i, k);
+                if (d == AllPairsResult<Weight>::infinity) w.null();
+                else w.value(d);
+            }
+            w.endArray();
+        }
+        w.endArray();
+    }
+
+    // "nodes" lista los IDs una sola vez; el "depth" de cada origen va alineado con
+    // ella (null si el vértice no se alcanza) y solo aparece si se pidieron profundidades
+    static void writeFields(JsonWriter& w, const MultiSourceBFSResult& r) {
+        w.field("type", "multi_bfs").field("vertex_count", r.vertexCount);
+
+        const bool depths = !r.depth.empty();
+        if (depths) {
+            w.key("nodes").beginArray();
+            for (std::size_t u = 0; u < r.depth.front().size(); ++u)
+                w.value(r.depth.front().index().id(static_cast<int>(u)));
+            w.endArray();
+        }
+
+        w.key("sources").beginArray();
+        for (std::size_t i = 0; i < r.sources.size(); ++i) {
+            w.beginObject()
+             .field("source", r.sources[i])
+             .field("reached", r.reached[i])
+             .field("eccentricity", r.eccentricity[i])
+             .field("distance_sum", r.distanceSum[i])
+             .field("closeness", r.closeness(i));
+            if (depths) {
+                w.key("depth").beginArray();
+                for (int d : r.depth[i].dense()) {
+                    if (d == std::numeric_limits<int>::max()) w.null();
+                    else w.value(d);
+                }
+                w.endArray();
+            }
+            w.endObject();
+        }
+        w.endArray();
+    }
+
+    // "sizes" va indexado por etiqueta; "component" da la etiqueta de cada nodo
+    static void writeFields(JsonWriter& w, const ComponentsResult& r) {
+        w.field("type", "components").field("strong", r.strong)
+         .field("component_count", r.count())
+         .field("largest_component", r.largest())
+         .field("singleton_components", r.singletons());
+
+        w.key("sizes").beginArray();
+        for (std::size_t s : r.sizes)
+            w.value(s);
+        w.endArray();
+
+        w.key("component").beginArray();
+        for (const auto& [id, c] : r.component) {
+            w.beginObject().field("node", id).field("component", c).endObject();
+        }
+        w.endArray();
+    }
+
+    static void writeFields(JsonWriter& w, const CentralityResult& r) {
+        w.field("type", "centrality").field("measure", r.measure)
+         .field("iterations", r.iterations)
+         .field("residual", r.residual)
+         .field("converged", r.converged);
+
+        w.key("scores").beginArray();
+        for (const auto& [id, score] : r.score) {
+            w.beginObject().field("node", id).field("score", score).endObject();
+        }
+        w.endArray();
+    }
+
+    static void writeFields(JsonWriter& w, const CountingTrace& t) {
+        w.field("vertices_settled", t.verticesSettled)
+         .field("edges_relaxed", t.edgesRelaxed)
+         .field("heap_pushes", t.heapPushes)
+         .field("stale_pops", t.stalePops);
+
+        w.key("phase_ms").beginObject();
+        for (std::size_t p = 0; p < TracePhaseCount; ++p) {
+            std::chrono::duration<double, std::milli> ms = t.phaseTime[p];
+            w.field(tracePhaseName(static_cast<TracePhase>(p)), ms.count());
+        }
+        w.endObject();
+    }
+
+private:
+    // Builds the VertexIndex of a deserialized result from the "node" fields of its arrays.
+    static std::shared_ptr<const VertexIndex> indexFromEntries(const nlohmann::json& a, const nlohmann::json& b) {
+        std::vector<int> ids;
+        ids.reserve(a.size() + b.size());
+        for (const auto& kv : a) ids.push_back(kv.at("node").get<int>());
+        for (const auto& kv : b) ids.push_back(kv.at("node").get<int>());
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return std::make_shared<const VertexIndex>(std::move(ids));
+    }
 };
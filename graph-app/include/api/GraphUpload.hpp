@@ -0,0 +1,295 @@
+#pragma once
+#include "graph_core/EdgeBuffer.hpp"
+#include "graph_core/GraphStorage.hpp"
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Graph read from a JSON upload with nlohmann's SAX parser.
+ *
+ * Accepts the "list" and "matrix" documents written by GraphAPI::serialize,
+ * with members in any order. Parsing never builds a DOM: nodes are collected
+ * as (id, label) pairs and edges go straight into an EdgeBuffer, from which
+ * buildList() / buildMatrix() construct the graph in bulk. Peak memory is the
+ * request body, the buffered edges and the graph itself.
+ *
+ * Missing members take these defaults: "type" is "list", "directed" false,
+ * "label" empty and "weight" 1. A "matrix" document must have a "size".
+ * Unknown members are ignored. Malformed input throws std::invalid_argument.
+ */
+template<typename Weight = double>
+class GraphUpload {
+public:
+    // Largest accepted matrix side; the matrix stores size * size weights.
+    static constexpr std::size_t maxMatrixSize = std::size_t{1} << 14;
+
+    static GraphUpload parse(std::string_view body) {
+        GraphUpload upload;
+        Reader reader(upload);
+        nlohmann::json::sax_parse(body, &reader);
+        if (upload.type_ != "list" && upload.type_ != "matrix")
+            throw std::invalid_argument("Unknown graph type: " + upload.type_);
+        if (upload.type_ == "matrix" && !upload.size_)
+            throw std::invalid_argument("Missing size for matrix graph");
+        if (upload.type_ == "matrix" && *upload.size_ > maxMatrixSize)
+            throw std::invalid_argument("Matrix size exceeds " + std::to_string(maxMatrixSize));
+        return upload;
+    }
+
+    bool isMatrix() const { return type_ == "matrix"; }
+    bool isDirected() const { return directed_; }
+    std::size_t nodeCount() const { return nodes_.size(); }
+    std::size_t edgeCount() const { return edges_.size(); }
+
+    // Both consume the buffered edges; call one of them once.
+    AdjacencyListGraph<Weight> buildList() {
+        return buildAdjacencyList(directed_, nodes_, std::move(edges_));
+    }
+
+    AdjacencyMatrixGraph<Weight> buildMatrix() {
+        try {
+            return buildAdjacencyMatrix(*size_, directed_, nodes_, std::move(edges_));
+        } catch (const std::out_of_range& e) {
+            throw std::invalid_argument(e.what());
+        }
+    }
+
+private:
+    GraphUpload() = default;
+
+    /**
+     * @brief SAX handler: a small state machine over the document structure.
+     *
+     * depth_ counts open containers: 1 inside the root object, 2 inside the
+     * "nodes"/"edges" arrays, 3 inside one node or edge object. Values deeper
+     * than that, or under unknown keys, are skipped: skip_ holds the depth of
+     * the outermost skipped container (0 while not skipping).
+     */
+    class Reader : public nlohmann::json_sax<nlohmann::json> {
+    public:
+        explicit Reader(GraphUpload& out) : out_(out) {}
+
+        bool null() override { return skip_ || scalar("null"); }
+        bool boolean(bool value) override {
+            if (skip_)
+                return true;
+            if (depth_ == 1 && section_ == Section::Directed) {
+                out_.directed_ = value;
+                return true;
+            }
+            return scalar("a boolean");
+        }
+        bool number_integer(number_integer_t value) override { return number(value, true); }
+        bool number_unsigned(number_unsigned_t value) override {
+            // beyond int64_t it can only be an invalid ID or size
+            return number(value > static_cast<number_unsigned_t>(std::numeric_limits<std::int64_t>::max())
+                              ? std::numeric_limits<std::int64_t>::max()
+                              : static_cast<std::int64_t>(value),
+                          true);
+        }
+        bool number_float(number_float_t value, const string_t&) override {
+            if (skip_)
+                return true;
+            if (depth_ == 3 && field_ == Field::Cost) {
+                weight_ = static_cast<Weight>(value);
+                return true;
+            }
+            return number(0, false);
+        }
+        bool string(string_t& value) override {
+            if (skip_)
+                return true;
+            if (depth_ == 1 && section_ == Section::Type) {
+                out_.type_ = std::move(value);
+                return true;
+            }
+            if (depth_ == 3 && field_ == Field::Label) {
+                label_ = std::move(value);
+                return true;
+            }
+            return scalar("a string");
+        }
+        bool binary(binary_t&) override { return skip_ || scalar("binary data"); }
+
+        bool start_object(std::size_t) override {
+            if (!skip_ && depth_ == 2) {
+                beginEntry();
+            } else if (!skip_ && depth_ != 0) {
+                skipContainer();
+            }
+            ++depth_;
+            return true;
+        }
+
+        bool end_object() override {
+            if (!skip_ && depth_ == 3)
+                endEntry();
+            leave();
+            return true;
+        }
+
+        bool start_array(std::size_t) override {
+            if (depth_ == 0)
+                throw std::invalid_argument("Graph must be a JSON object");
+            if (!skip_ && depth_ == 2)
+                throw std::invalid_argument(entryName() + " entries must be objects");
+            if (!skip_ && !(depth_ == 1 && (section_ == Section::Nodes || section_ == Section::Edges)))
+                skipContainer();
+            ++depth_;
+            return true;
+        }
+
+        bool end_array() override {
+            leave();
+            return true;
+        }
+
+        bool key(string_t& name) override {
+            if (skip_)
+                return true;
+            if (depth_ == 1) {
+                section_ = name == "type"       ? Section::Type
+                         : name == "directed"   ? Section::Directed
+                         : name == "size"       ? Section::Size
+                         : name == "nodes"      ? Section::Nodes
+                         : name == "edges"      ? Section::Edges
+                                                : Section::Other;
+            } else if (depth_ == 3) {
+                field_ = name == "id"     ? Field::Id
+                       : name == "label"  ? Field::Label
+                       : name == "from"   ? Field::From
+                       : name == "to"     ? Field::To
+                       : name == "weight" ? Field::Cost
+                                          : Field::Other;
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::json::exception& e) override {
+            throw std::invalid_argument(e.what());
+        }
+
+    private:
+        enum class Section { Other, Type, Directed, Size, Nodes, Edges };
+        enum class Field { Other, Id, Label, From, To, Cost }; // Cost: "weight"
+
+        // Integer (or, with integral == false, floating-point) value at the current position.
+        bool number(std::int64_t value, bool integral) {
+            if (skip_)
+                return true;
+            if (depth_ == 1 && section_ == Section::Size && integral && value >= 0) {
+                out_.size_ = static_cast<std::size_t>(value);
+                return true;
+            }
+            if (depth_ == 3 && field_ == Field::Cost) {
+                weight_ = static_cast<Weight>(value);
+                return true;
+            }
+            if (depth_ == 3 && (field_ == Field::Id || field_ == Field::From || field_ == Field::To)) {
+                if (!integral || value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+                    throw std::invalid_argument(entryName() + " IDs must be 32-bit integers");
+                (field_ == Field::Id ? id_ : field_ == Field::From ? from_ : to_) = static_cast<int>(value);
+                return true;
+            }
+            return scalar("a number");
+        }
+
+        // Scalar that is not one of the recognised members: an error where a known member
+        // or an entry was expected, ignored anywhere else.
+        bool scalar(const char* what) {
+            if (depth_ == 0)
+                throw std::invalid_argument("Graph must be a JSON object");
+            if (depth_ == 1 && section_ != Section::Other)
+                throw std::invalid_argument("Invalid value for " + sectionName() + ": " + what);
+            if (depth_ == 2)
+                throw std::invalid_argument(entryName() + " entries must be objects");
+            if (depth_ == 3 && field_ != Field::Other)
+                throw std::invalid_argument("Invalid " + fieldName() + " in " + entryName() + " entry: " + what);
+            return true;
+        }
+
+        // A nested object or array is only valid under members we ignore; skip it whole.
+        void skipContainer() {
+            if (depth_ == 1 && section_ != Section::Other)
+                throw std::invalid_argument("Invalid value for " + sectionName());
+            if (depth_ == 3 && field_ != Field::Other)
+                throw std::invalid_argument("Invalid " + fieldName() + " in " + entryName() + " entry");
+            skip_ = depth_ + 1;
+        }
+
+        void leave() {
+            if (skip_ == depth_)
+                skip_ = 0;
+            --depth_;
+        }
+
+        void beginEntry() {
+            field_ = Field::Other;
+            id_.reset();
+            from_.reset();
+            to_.reset();
+            weight_.reset();
+            label_.clear();
+        }
+
+        void endEntry() {
+            if (section_ == Section::Nodes) {
+                if (!id_)
+                    throw std::invalid_argument("Node entry without id");
+                out_.nodes_.emplace_back(*id_, std::move(label_));
+                label_.clear();
+            } else {
+                if (!from_ || !to_)
+                    throw std::invalid_argument("Edge entry without from/to");
+                out_.edges_.push(*from_, *to_, weight_.value_or(Weight{1}));
+            }
+        }
+
+        std::string sectionName() const {
+            switch (section_) {
+                case Section::Type: return "type";
+                case Section::Directed: return "directed";
+                case Section::Size: return "size";
+                case Section::Nodes: return "nodes";
+                case Section::Edges: return "edges";
+                default: return "member";
+            }
+        }
+
+        std::string fieldName() const {
+            switch (field_) {
+                case Field::Id: return "id";
+                case Field::Label: return "label";
+                case Field::From: return "from";
+                case Field::To: return "to";
+                case Field::Cost: return "weight";
+                default: return "member";
+            }
+        }
+
+        std::string entryName() const { return section_ == Section::Nodes ? "Node" : "Edge"; }
+
+        GraphUpload& out_;
+        int depth_ = 0;
+        int skip_ = 0;
+        Section section_ = Section::Other;
+        Field field_ = Field::Other;
+        std::optional<int> id_, from_, to_;
+        std::optional<Weight> weight_;
+        std::string label_;
+    };
+
+    std::string type_ = "list";
+    bool directed_ = false;
+    std::optional<std::size_t> size_;
+    std::vector<std::pair<int, std::string>> nodes_;
+    EdgeBuffer<Weight> edges_;
+};
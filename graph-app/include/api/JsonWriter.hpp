@@ -0,0 +1,149 @@
+#pragma once
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Single-pass JSON writer that appends straight to an output string.
+ *
+ * Values are formatted as they are produced, without building a DOM, so the
+ * only copy of a response is the output buffer itself (which is then moved
+ * into crow::response::body). The writer inserts commas and key separators;
+ * callers only have to nest begin/end calls correctly. Floating-point values
+ * use the shortest round-trip form and non-finite values are written as null,
+ * as nlohmann::json::dump() does.
+ */
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    JsonWriter& beginObject() {
+        separate();
+        out_ += '{';
+        first_.push_back(true);
+        return *this;
+    }
+
+    JsonWriter& endObject() {
+        first_.pop_back();
+        out_ += '}';
+        return *this;
+    }
+
+    JsonWriter& beginArray() {
+        separate();
+        out_ += '[';
+        first_.push_back(true);
+        return *this;
+    }
+
+    JsonWriter& endArray() {
+        first_.pop_back();
+        out_ += ']';
+        return *this;
+    }
+
+    JsonWriter& key(std::string_view name) {
+        separate();
+        writeString(name);
+        out_ += ':';
+        afterKey_ = true;
+        return *this;
+    }
+
+    JsonWriter& null() {
+        separate();
+        out_ += "null";
+        return *this;
+    }
+
+    JsonWriter& value(std::string_view s) {
+        separate();
+        writeString(s);
+        return *this;
+    }
+
+    JsonWriter& value(const char* s) { return value(std::string_view(s)); }
+
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    JsonWriter& value(T v) {
+        separate();
+        if constexpr (std::is_same_v<T, bool>) {
+            out_ += v ? "true" : "false";
+        } else if constexpr (std::is_floating_point_v<T>) {
+            if (!std::isfinite(v)) {
+                out_ += "null";
+                return *this;
+            }
+            char buffer[32];
+            auto [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), v);
+            const std::string_view text(buffer, static_cast<std::size_t>(end - buffer));
+            out_ += text;
+            // keep it a JSON float, like nlohmann ("3.0", not "3")
+            if (text.find_first_of(".e") == std::string_view::npos)
+                out_ += ".0";
+        } else {
+            char buffer[24];
+            auto [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), v);
+            out_.append(buffer, end);
+        }
+        return *this;
+    }
+
+    // key(name) followed by value(v).
+    template<typename T>
+    JsonWriter& field(std::string_view name, const T& v) {
+        key(name);
+        return value(v);
+    }
+
+private:
+    void separate() {
+        if (afterKey_) {
+            afterKey_ = false;
+            return;
+        }
+        if (!first_.empty()) {
+            if (!first_.back())
+                out_ += ',';
+            first_.back() = false;
+        }
+    }
+
+    void writeString(std::string_view s) {
+        static constexpr char hex[] = "0123456789abcdef";
+        out_ += '"';
+        std::size_t run = 0; // start of the pending run of characters that need no escaping
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            const unsigned char c = static_cast<unsigned char>(s[i]);
+            if (c >= 0x20 && c != '"' && c != '\\')
+                continue;
+            out_.append(s.data() + run, i - run);
+            run = i + 1;
+            switch (c) {
+                case '"': out_ += "\\\""; break;
+                case '\\': out_ += "\\\\"; break;
+                case '\b': out_ += "\\b"; break;
+                case '\f': out_ += "\\f"; break;
+                case '\n': out_ += "\\n"; break;
+                case '\r': out_ += "\\r"; break;
+                case '\t': out_ += "\\t"; break;
+                default:
+                    out_ += "\\u00";
+                    out_ += hex[c >> 4];
+                    out_ += hex[c & 15];
+            }
+        }
+        out_.append(s.data() + run, s.size() - run);
+        out_ += '"';
+    }
+
+    std::string& out_;
+    std::vector<bool> first_; // per open container: nothing written in it yet
+    bool afterKey_ = false;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include "metrics/Metrics.hpp"
+#include <crow.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Crow middleware that times every request and records it in a Metrics registry.
+ *
+ * The route label is the request path with its numeric segments replaced by
+ * <int>, the same pattern the routes are declared with (e.g. /jobs/<int>/result),
+ * so requests for different graphs or jobs share one series.
+ */
+struct MetricsMiddleware {
+    using Clock = std::chrono::steady_clock;
+
+    struct context {
+        Clock::time_point started;
+    };
+
+    Metrics* metrics = nullptr; // set before the app starts serving
+
+    void before_handle(crow::request&, crow::response&, context& ctx) { ctx.started = Clock::now(); }
+
+    void after_handle(crow::request& req, crow::response& res, context& ctx) {
+        if (metrics)
+            metrics->observeRequest(routeOf(req.url), res.code, Clock::now() - ctx.started);
+    }
+
+    static std::string routeOf(std::string_view url) {
+        url = url.substr(0, url.find('?'));
+        std::string route;
+        route.reserve(url.size());
+        while (!url.empty()) {
+            const auto slash = url.find('/', 1);
+            std::string_view segment = url.substr(0, slash);
+            url.remove_prefix(segment.size());
+            const bool numeric = segment.size() > 1 && std::all_of(segment.begin() + 1, segment.end(), [](char c) {
+                return std::isdigit(static_cast<unsigned char>(c)) || c == '-';
+            });
+            route.append(numeric ? std::string_view("/<int>") : segment);
+        }
+        return route;
+    }
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Fixed-size bit set stored in 64-bit words.
+ *
+ * set() is a plain write and is only safe when each word has a single writer;
+ * setAtomic() may be called concurrently from any thread.
+ */
+class Bitmap {
+public:
+    explicit Bitmap(std::size_t n = 0) : size_(n), words_((n + 63) / 64, 0) {}
+
+    std::size_t size() const { return size_; }
+    std::size_t wordCount() const { return words_.size(); }
+    std::uint64_t word(std::size_t w) const { return words_[w]; }
+
+    bool test(std::size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1; }
+
+    void set(std::size_t i) { words_[i >> 6] |= bit(i); }
+
+    // Returns true if this call flipped the bit.
+    bool setAtomic(std::size_t i) {
+        std::atomic_ref<std::uint64_t> w(words_[i >> 6]);
+        return !(w.fetch_or(bit(i), std::memory_order_relaxed) & bit(i));
+    }
+
+    void clear() { std::fill(words_.begin(), words_.end(), 0); }
+
+    std::size_t count() const {
+        std::size_t c = 0;
+        for (std::uint64_t w : words_)
+            c += static_cast<std::size_t>(std::popcount(w));
+        return c;
+    }
+
+    // Calls f(i) for every set bit in words [wordBegin, wordEnd).
+    template <typename F>
+    void forEachSetBit(std::size_t wordBegin, std::size_t wordEnd, F &&f) const {
+        for (std::size_t w = wordBegin; w < wordEnd; ++w) {
+            std::uint64_t bits = words_[w];
+            while (bits) {
+                f((w << 6) + static_cast<std::size_t>(std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    void swap(Bitmap &other) noexcept {
+        std::swap(size_, other.size_);
+        words_.swap(other.words_);
+    }
+
+private:
+    static std::uint64_t bit(std::size_t i) { return std::uint64_t{1} << (i & 63); }
+
+    std::size_t size_;
+    std::vector<std::uint64_t> words_;
+};
@@ -0,0 +1,323 @@
+#pragma once
+#include "CsrGraph.hpp"
+#include "GraphConcepts.hpp"
+#include "Parallel.hpp"
+#include "Trace.hpp"
+#include "VertexIndex.hpp"
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ---------- Resultado de las centralidades iterativas ----------
+
+struct CentralityResult
+{
+    std::string measure;       // "pagerank", "personalized_pagerank" o "katz"
+    VertexMap<double> score;   // puntuación de cada nodo
+    std::size_t iterations = 0;
+    double residual = 0.0;     // cambio (norma L1) de la última iteración
+    bool converged = false;
+};
+
+namespace Algorithms
+{
+    struct PageRankOptions
+    {
+        unsigned threads = 0;          // 0 = hardware_concurrency
+        double damping = 0.85;
+        double tolerance = 1e-6;       // se para cuando la norma L1 del cambio baja de aquí
+        std::size_t maxIterations = 100;
+    };
+
+    struct KatzOptions
+    {
+        unsigned threads = 0;          // 0 = hardware_concurrency
+        double alpha = 0.1;            // debe ser menor que 1 / (mayor autovalor de A) para converger
+        double beta = 1.0;
+        double tolerance = 1e-6;       // cambio L1 relativo a la norma L1 de las puntuaciones
+        std::size_t maxIterations = 1000;
+        bool normalized = true;        // divide el resultado por su norma L2
+    };
+
+    namespace detail
+    {
+        // Suma x[u] sobre una lista de vecinos con cuatro acumuladores independientes:
+        // rompe la cadena de dependencias de la suma y deja al compilador vectorizar
+        // las lecturas (gather) cuando el objetivo lo permite.
+        inline double gatherSum(std::span<const int> nbrs, const double *x)
+        {
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            const std::size_t m = nbrs.size();
+            std::size_t k = 0;
+            for (; k + 4 <= m; k += 4)
+            {
+                s0 += x[nbrs[k]];
+                s1 += x[nbrs[k + 1]];
+                s2 += x[nbrs[k + 2]];
+                s3 += x[nbrs[k + 3]];
+            }
+            for (; k < m; ++k)
+                s0 += x[nbrs[k]];
+            return (s0 + s1) + (s2 + s3);
+        }
+
+        // Cortes [rows[t], rows[t + 1]) con un coste parecido por hilo, contando cada
+        // fila como sus aristas de entrada más una.
+        template <IndexedGraph G>
+        std::vector<std::size_t> balancedRows(const G &incoming, unsigned threads)
+        {
+            const std::size_t n = incoming.vertexCount();
+            std::size_t total = n;
+            for (std::size_t v = 0; v < n; ++v)
+                total += incoming.neighbors(static_cast<int>(v)).size();
+
+            std::vector<std::size_t> rows(threads + 1, n);
+            rows[0] = 0;
+            std::size_t acc = 0, v = 0;
+            for (unsigned t = 1; t < threads; ++t)
+            {
+                const std::size_t target = total / threads * t;
+                while (v < n && acc < target)
+                    acc += incoming.neighbors(static_cast<int>(v++)).size() + 1;
+                rows[t] = v;
+            }
+            return rows;
+        }
+
+        // Una iteración del producto "pull":
+        //   next[v] = update(v, suma de contrib[u] sobre las aristas u -> v, leak)
+        // donde contrib[u] = scale[u] * x[u] y leak es la masa de los vértices con
+        // scale 0 (sumideros en PageRank). En la misma pasada se calculan el cambio
+        // respecto a x, la norma de next y sus contribuciones para la siguiente.
+        struct PullStep
+        {
+            double change = 0.0; // norma L1 de next - x
+            double total = 0.0;  // norma L1 de next
+            double leak = 0.0;   // suma de next en los vértices con scale 0
+        };
+
+        template <IndexedGraph G, typename Update>
+        PullStep pullStep(const G &incoming, const std::vector<std::size_t> &rows, const std::vector<double> &scale,
+                          const std::vector<double> &contrib, std::vector<double> &x,
+                          std::vector<double> &nextContrib, Update &&update)
+        {
+            struct alignas(64) Partial
+            {
+                PullStep step;
+            };
+            const unsigned threads = static_cast<unsigned>(rows.size() - 1);
+            std::vector<Partial> partial(threads);
+            Parallel::run(threads, [&](unsigned tid)
+            {
+                PullStep local;
+                for (std::size_t v = rows[tid]; v < rows[tid + 1]; ++v)
+                {
+                    const double sum = gatherSum(incoming.neighbors(static_cast<int>(v)), contrib.data());
+                    const double next = update(v, sum);
+                    local.change += std::abs(next - x[v]);
+                    local.total += std::abs(next);
+                    if (scale[v] == 0.0)
+                        local.leak += next;
+                    x[v] = next;
+                    nextContrib[v] = scale[v] * next;
+                }
+                partial[tid].step = local;
+            });
+
+            PullStep step;
+            for (const auto &p : partial)
+            {
+                step.change += p.step.change;
+                step.total += p.step.total;
+                step.leak += p.step.leak;
+            }
+            return step;
+        }
+
+        // PageRank con vector de teletransporte `teleport` (vacío = uniforme 1/n).
+        template <IndexedGraph G, TracePolicy Trace>
+        CentralityResult pageRank(const G &out, const G &incoming, std::vector<double> teleport,
+                                  const PageRankOptions &options, Trace &trace)
+        {
+            CentralityResult result;
+            trace.phaseBegin(TracePhase::Init);
+            const std::size_t n = out.vertexCount();
+            result.score = VertexMap<double>(out.sharedVertexIndex(), 0.0);
+            if (n == 0)
+            {
+                trace.phaseEnd(TracePhase::Init);
+                return result;
+            }
+            const double uniform = 1.0 / static_cast<double>(n);
+            auto jump = [&](std::size_t v) { return teleport.empty() ? uniform : teleport[v]; };
+
+            std::size_t edges = 0;
+            std::vector<double> scale(n), contrib(n), nextContrib(n);
+            auto &x = result.score.dense();
+            double leak = 0.0;
+            for (std::size_t v = 0; v < n; ++v)
+            {
+                const std::size_t degree = out.neighbors(static_cast<int>(v)).size();
+                edges += degree;
+                scale[v] = degree == 0 ? 0.0 : 1.0 / static_cast<double>(degree);
+                x[v] = jump(v);
+                contrib[v] = scale[v] * x[v];
+                if (degree == 0)
+                    leak += x[v];
+            }
+            const unsigned threads = Parallel::threadsFor(n + edges, options.threads, 1 << 16);
+            const auto rows = balancedRows(incoming, threads);
+            const double d = options.damping;
+            trace.phaseEnd(TracePhase::Init);
+
+            // la masa de los sumideros se reparte como el teletransporte
+            trace.phaseBegin(TracePhase::Search);
+            while (result.iterations < options.maxIterations)
+            {
+                const double sinks = leak;
+                const auto step = pullStep(incoming, rows, scale, contrib, x, nextContrib,
+                                           [&](std::size_t v, double sum)
+                                           {
+                                               const double t = jump(v);
+                                               return (1.0 - d) * t + d * (sum + sinks * t);
+                                           });
+                contrib.swap(nextContrib);
+                leak = step.leak;
+                ++result.iterations;
+                result.residual = step.change;
+                trace.vertexSettled(n);
+                trace.edgeRelaxed(edges);
+                if (step.change < options.tolerance)
+                {
+                    result.converged = true;
+                    break;
+                }
+            }
+            trace.phaseEnd(TracePhase::Search);
+            return result;
+        }
+    } // namespace detail
+
+    // ---------- PageRank (SpMV "pull") ----------
+    //
+    // Iteración de potencias x' = (1 - d) t + d (A^T D^-1 x + s t), con D los grados de
+    // salida, t el teletransporte (uniforme) y s la masa de los sumideros. Cada vértice
+    // suma las contribuciones x[u] / grado(u) de sus aristas de entrada (CSR traspuesta):
+    // es un producto matriz dispersa-vector por filas, en el que cada hilo escribe solo
+    // sus filas y no hacen falta atómicos. Las filas se reparten por número de aristas,
+    // no de vértices, para que los vértices de grado alto no desequilibren los hilos. El
+    // cambio L1 y las contribuciones de la iteración siguiente se calculan en la misma
+    // pasada. Los pesos de las aristas no se usan. Las puntuaciones suman 1.
+    //
+    // La traza recibe n vértices y m aristas por iteración.
+
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    CentralityResult PageRank(const G &out, const G &incoming, PageRankOptions options = {}, Trace &&trace = {})
+    {
+        auto r = detail::pageRank(out, incoming, {}, options, trace);
+        r.measure = "pagerank";
+        return r;
+    }
+
+    // PageRank personalizado: el teletransporte (y la masa de los sumideros) vuelve
+    // solo a `sources`, a partes iguales. Los IDs que no están en el grafo se
+    // ignoran; sin ninguno válido, todas las puntuaciones son 0.
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    CentralityResult PersonalizedPageRank(const G &out, const G &incoming, std::span<const int> sources,
+                                          PageRankOptions options = {}, Trace &&trace = {})
+    {
+        std::vector<int> known;
+        for (int id : sources)
+        {
+            if (const int s = out.indexOf(id); s >= 0)
+                known.push_back(s);
+        }
+        CentralityResult r;
+        if (known.empty())
+        {
+            r.score = VertexMap<double>(out.sharedVertexIndex(), 0.0);
+        }
+        else
+        {
+            std::vector<double> teleport(out.vertexCount(), 0.0);
+            for (int s : known)
+                teleport[s] += 1.0 / static_cast<double>(known.size());
+            r = detail::pageRank(out, incoming, std::move(teleport), options, trace);
+        }
+        r.measure = "personalized_pagerank";
+        return r;
+    }
+
+    // ---------- Centralidad de Katz ----------
+    //
+    // x' = alpha A^T x + beta, desde x = 0, con el mismo producto "pull" que PageRank:
+    // cada vértice suma las puntuaciones de sus vecinos de entrada. Converge si alpha
+    // es menor que 1 / (mayor autovalor de A); si no, las puntuaciones crecen sin
+    // límite y se para en cuanto dejan de ser finitas (converged = false).
+
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    CentralityResult KatzCentrality(const G &out, const G &incoming, KatzOptions options = {}, Trace &&trace = {})
+    {
+        CentralityResult result;
+        result.measure = "katz";
+        trace.phaseBegin(TracePhase::Init);
+        const std::size_t n = out.vertexCount();
+        result.score = VertexMap<double>(out.sharedVertexIndex(), 0.0);
+        std::size_t edges = 0;
+        for (std::size_t v = 0; v < n; ++v)
+            edges += incoming.neighbors(static_cast<int>(v)).size();
+        const unsigned threads = Parallel::threadsFor(n + edges, options.threads, 1 << 16);
+        const auto rows = detail::balancedRows(incoming, threads);
+        std::vector<double> scale(n, 1.0), contrib(n, 0.0), nextContrib(n);
+        auto &x = result.score.dense();
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        while (n > 0 && result.iterations < options.maxIterations)
+        {
+            const auto step = detail::pullStep(incoming, rows, scale, contrib, x, nextContrib,
+                                               [&](std::size_t, double sum)
+                                               { return options.alpha * sum + options.beta; });
+            contrib.swap(nextContrib);
+            ++result.iterations;
+            result.residual = step.change;
+            trace.vertexSettled(n);
+            trace.edgeRelaxed(edges);
+            if (!std::isfinite(step.total))
+                break;
+            if (step.change <= options.tolerance * step.total)
+            {
+                result.converged = true;
+                break;
+            }
+        }
+        trace.phaseEnd(TracePhase::Search);
+
+        trace.phaseBegin(TracePhase::Finalize);
+        if (options.normalized && result.converged)
+        {
+            double norm = 0.0;
+            for (double s : x)
+                norm += s * s;
+            norm = std::sqrt(norm);
+            if (norm > 0.0)
+            {
+                for (double &s : x)
+                    s /= norm;
+            }
+        }
+        trace.phaseEnd(TracePhase::Finalize);
+        return result;
+    }
+
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    CentralityResult PageRank(const CsrGraph<Weight> &g, PageRankOptions options = {}, Trace &&trace = {})
+    {
+        if (!g.isDirected())
+            return PageRank(g, g, options, std::forward<Trace>(trace));
+        return PageRank(g, g.transposed(), options, std::forward<Trace>(trace));
+    }
+} // namespace Algorithms
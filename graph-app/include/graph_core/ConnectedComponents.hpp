@@ -0,0 +1,460 @@
+#pragma once
+#include "CsrGraph.hpp"
+#include "GraphConcepts.hpp"
+#include "Parallel.hpp"
+#include "ParallelBFS.hpp"
+#include "Trace.hpp"
+#include "VertexIndex.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ---------- Resultado de componentes conexas ----------
+
+struct ComponentsResult
+{
+    bool strong = false;            // componentes fuertemente conexas (grafo dirigido)
+    VertexMap<int> component;       // etiqueta de cada nodo, de 0 a count() - 1
+    std::vector<std::size_t> sizes; // nodos de cada componente, por etiqueta
+
+    // Las etiquetas siguen el orden del menor índice denso de cada componente,
+    // así que no dependen del número de hilos.
+    std::size_t count() const { return sizes.size(); }
+    std::size_t largest() const { return sizes.empty() ? 0 : *std::max_element(sizes.begin(), sizes.end()); }
+    std::size_t singletons() const { return static_cast<std::size_t>(std::count(sizes.begin(), sizes.end(), 1)); }
+};
+
+namespace Algorithms
+{
+    struct ComponentsOptions
+    {
+        unsigned threads = 0;           // 0 = hardware_concurrency
+        std::size_t neighborRounds = 2; // Afforest: aristas por vértice enlazadas antes del muestreo
+        std::size_t samples = 1024;     // Afforest: vértices muestreados para hallar la componente grande
+    };
+
+    namespace detail
+    {
+        constexpr std::size_t componentChunk = 4096; // vértices por bloque de trabajo
+
+        inline int loadParent(std::vector<int> &comp, int v)
+        {
+            return std::atomic_ref<int>(comp[v]).load(std::memory_order_relaxed);
+        }
+
+        // Une los árboles de u y v sin bloqueos (Shiloach–Vishkin, como en Afforest): la raíz
+        // mayor pasa a colgar de la menor con un CAS, y si otro hilo se adelanta se reintenta
+        // desde los nuevos padres. La raíz de cada árbol es su vértice de menor índice.
+        inline void link(std::vector<int> &comp, int u, int v)
+        {
+            int p1 = loadParent(comp, u), p2 = loadParent(comp, v);
+            while (p1 != p2)
+            {
+                const int high = std::max(p1, p2), low = std::min(p1, p2);
+                int highParent = loadParent(comp, high);
+                if (highParent == low)
+                    break;
+                if (highParent == high
+                    && std::atomic_ref<int>(comp[high]).compare_exchange_strong(highParent, low,
+                                                                                std::memory_order_relaxed))
+                    break;
+                p1 = loadParent(comp, loadParent(comp, high));
+                p2 = loadParent(comp, low);
+            }
+        }
+
+        // Deja cada vértice apuntando directamente a la raíz de su árbol.
+        inline void compress(std::vector<int> &comp, unsigned threads)
+        {
+            Parallel::forChunks(comp.size(), threads, componentChunk, [&](std::size_t begin, std::size_t end, unsigned)
+            {
+                for (std::size_t v = begin; v < end; ++v)
+                {
+                    int p = loadParent(comp, static_cast<int>(v));
+                    for (int pp = loadParent(comp, p); p != pp; pp = loadParent(comp, p))
+                        p = pp;
+                    std::atomic_ref<int>(comp[v]).store(p, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        // Etiquetas 0..k-1 por orden de aparición de cada representante y tamaños.
+        inline void relabel(const std::vector<int> &representative, ComponentsResult &r)
+        {
+            auto &label = r.component.dense();
+            std::vector<int> labelOf(representative.size(), -1);
+            for (std::size_t v = 0; v < representative.size(); ++v)
+            {
+                int &l = labelOf[representative[v]];
+                if (l < 0)
+                {
+                    l = static_cast<int>(r.sizes.size());
+                    r.sizes.push_back(0);
+                }
+                label[v] = l;
+                ++r.sizes[l];
+            }
+        }
+    } // namespace detail
+
+    // ---------- Componentes conexas (Afforest) ----------
+    //
+    // Union-find concurrente con muestreo (Sutton et al., "Optimizing Parallel
+    // Graph Connectivity Computation via Subgraph Sampling"):
+    //   1. cada vértice enlaza solo sus `neighborRounds` primeras aristas, lo que
+    //      ya une casi toda la componente grande en grafos reales;
+    //   2. se muestrean `samples` vértices y la raíz más frecuente se toma como
+    //      la componente grande;
+    //   3. los vértices que no están en ella enlazan el resto de sus aristas. Los
+    //      de la componente grande no necesitan recorrer las suyas: cualquier
+    //      arista hacia fuera la enlaza el otro extremo, que sí se procesa.
+    // Cada enlace es un CAS sobre el vector de padres y entre fases se
+    // comprimen los caminos. El trabajo es casi lineal y no depende del número
+    // ni del tamaño de las componentes.
+    //
+    // `incoming` son las aristas de entrada de `out`. Si es el propio `out`
+    // (grafo no dirigido) basta con las de salida; si no, los vértices fuera de
+    // la componente grande enlazan también las de entrada y el resultado son
+    // las componentes débilmente conexas.
+
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    ComponentsResult ConnectedComponents(const G &out, const G &incoming, ComponentsOptions options = {},
+                                         Trace &&trace = {})
+    {
+        ComponentsResult result;
+        trace.phaseBegin(TracePhase::Init);
+        const std::size_t n = out.vertexCount();
+        const bool symmetric = static_cast<const void *>(&out) == static_cast<const void *>(&incoming);
+        result.component = VertexMap<int>(out.sharedVertexIndex(), -1);
+        const unsigned threads = Parallel::threadsFor(n, options.threads, detail::componentChunk);
+        std::vector<int> comp(n);
+        std::iota(comp.begin(), comp.end(), 0);
+        std::vector<std::size_t> linked(threads, 0); // aristas enlazadas por hilo (solo con Trace::enabled)
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        for (std::size_t round = 0; round < options.neighborRounds; ++round)
+        {
+            Parallel::forChunks(n, threads, detail::componentChunk, [&](std::size_t begin, std::size_t end, unsigned tid)
+            {
+                for (std::size_t u = begin; u < end; ++u)
+                {
+                    const auto nbrs = out.neighbors(static_cast<int>(u));
+                    if (round < nbrs.size())
+                    {
+                        detail::link(comp, static_cast<int>(u), nbrs[round]);
+                        if constexpr (std::remove_cvref_t<Trace>::enabled)
+                            ++linked[tid];
+                    }
+                }
+            });
+            detail::compress(comp, threads);
+        }
+
+        // componente más frecuente en una muestra (semilla fija: resultado reproducible)
+        int largest = -1;
+        if (n > 0)
+        {
+            std::mt19937 gen(n);
+            std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+            std::vector<int> sample(options.samples);
+            for (int &s : sample)
+                s = comp[pick(gen)];
+            std::sort(sample.begin(), sample.end());
+            std::size_t best = 0;
+            for (std::size_t i = 0; i < sample.size();)
+            {
+                const std::size_t j = static_cast<std::size_t>(
+                    std::upper_bound(sample.begin() + i, sample.end(), sample[i]) - sample.begin());
+                if (j - i > best)
+                {
+                    best = j - i;
+                    largest = sample[i];
+                }
+                i = j;
+            }
+        }
+
+        Parallel::forChunks(n, threads, detail::componentChunk, [&](std::size_t begin, std::size_t end, unsigned tid)
+        {
+            for (std::size_t u = begin; u < end; ++u)
+            {
+                if (detail::loadParent(comp, static_cast<int>(u)) == largest)
+                    continue;
+                const auto nbrs = out.neighbors(static_cast<int>(u));
+                for (std::size_t k = options.neighborRounds; k < nbrs.size(); ++k)
+                    detail::link(comp, static_cast<int>(u), nbrs[k]);
+                std::size_t done = nbrs.size() > options.neighborRounds ? nbrs.size() - options.neighborRounds : 0;
+                if (!symmetric)
+                {
+                    for (int v : incoming.neighbors(static_cast<int>(u)))
+                        detail::link(comp, static_cast<int>(u), v);
+                    done += incoming.neighbors(static_cast<int>(u)).size();
+                }
+                if constexpr (std::remove_cvref_t<Trace>::enabled)
+                    linked[tid] += done;
+            }
+        });
+        detail::compress(comp, threads);
+        trace.vertexSettled(n);
+        for (std::size_t l : linked)
+            trace.edgeRelaxed(l);
+        trace.phaseEnd(TracePhase::Search);
+
+        trace.phaseBegin(TracePhase::Finalize);
+        detail::relabel(comp, result);
+        trace.phaseEnd(TracePhase::Finalize);
+        return result;
+    }
+
+    // ---------- Componentes fuertemente conexas ----------
+    //
+    // Método de Hong et al. ("On Fast Parallel Detection of Strongly Connected
+    // Components in Small-World Graphs"):
+    //   1. poda: un vértice sin aristas de entrada o de salida (contando solo
+    //      las de vértices no podados) es una componente por sí solo. Se poda con
+    //      una lista de trabajo, en tiempo lineal;
+    //   2. forward-backward: desde un pivote de grado alto, las BFS paralelas
+    //      hacia delante y hacia atrás (ParallelBFS) se cortan justo en su
+    //      componente, normalmente la gigante;
+    //   3. lo que queda se parte en componentes débilmente conexas con el
+    //      union-find concurrente de Afforest. Ninguna componente fuerte cruza de
+    //      una débil a otra, así que cada una se resuelve con un Tarjan iterativo
+    //      independiente, repartidas entre hilos de mayor a menor.
+    // El trabajo total es lineal: cada fase recorre cada arista a lo sumo una vez
+    // (las BFS del paso 2, dos veces).
+
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    ComponentsResult StronglyConnectedComponents(const G &out, const G &incoming, ComponentsOptions options = {},
+                                                 Trace &&trace = {})
+    {
+        constexpr int unassigned = -1;
+        constexpr int unvisited = std::numeric_limits<int>::max();
+
+        ComponentsResult result;
+        result.strong = true;
+        trace.phaseBegin(TracePhase::Init);
+        const std::size_t n = out.vertexCount();
+        result.component = VertexMap<int>(out.sharedVertexIndex(), -1);
+        const unsigned threads = Parallel::threadsFor(n, options.threads, detail::componentChunk);
+        std::vector<int> scc(n, unassigned); // representante de la componente de cada vértice
+        std::vector<int> inDegree(n), outDegree(n);
+        Parallel::forChunks(n, threads, detail::componentChunk, [&](std::size_t begin, std::size_t end, unsigned)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+            {
+                outDegree[v] = static_cast<int>(out.neighbors(static_cast<int>(v)).size());
+                inDegree[v] = static_cast<int>(incoming.neighbors(static_cast<int>(v)).size());
+            }
+        });
+        std::size_t scanned = 0;
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        // 1. poda
+        std::vector<int> work;
+        for (std::size_t v = 0; v < n; ++v)
+        {
+            if (inDegree[v] == 0 || outDegree[v] == 0)
+            {
+                scc[v] = static_cast<int>(v);
+                work.push_back(static_cast<int>(v));
+            }
+        }
+        while (!work.empty())
+        {
+            const int u = work.back();
+            work.pop_back();
+            for (int v : out.neighbors(u))
+            {
+                if (scc[v] == unassigned && --inDegree[v] == 0)
+                {
+                    scc[v] = v;
+                    work.push_back(v);
+                }
+            }
+            for (int v : incoming.neighbors(u))
+            {
+                if (scc[v] == unassigned && --outDegree[v] == 0)
+                {
+                    scc[v] = v;
+                    work.push_back(v);
+                }
+            }
+            scanned += out.neighbors(u).size() + incoming.neighbors(u).size();
+        }
+
+        // 2. forward-backward desde el vértice restante con más caminos a su paso
+        int pivot = -1;
+        std::uint64_t pivotScore = 0;
+        for (std::size_t v = 0; v < n; ++v)
+        {
+            const std::uint64_t score = static_cast<std::uint64_t>(inDegree[v]) * static_cast<std::uint64_t>(outDegree[v]);
+            if (scc[v] == unassigned && (pivot < 0 || score > pivotScore))
+            {
+                pivot = static_cast<int>(v);
+                pivotScore = score;
+            }
+        }
+        if (pivot >= 0)
+        {
+            ParallelBFSOptions bfsOptions;
+            bfsOptions.threads = threads;
+            const int pivotId = out.vertexId(pivot);
+            const auto forward = ParallelBFS(out, incoming, pivotId, bfsOptions);
+            const auto backward = ParallelBFS(incoming, out, pivotId, bfsOptions);
+            const auto &fd = forward.depth.dense();
+            const auto &bd = backward.depth.dense();
+            Parallel::forChunks(n, threads, detail::componentChunk, [&](std::size_t begin, std::size_t end, unsigned)
+            {
+                for (std::size_t v = begin; v < end; ++v)
+                {
+                    if (fd[v] != unvisited && bd[v] != unvisited)
+                        scc[v] = pivot;
+                }
+            });
+        }
+
+        // 3. componentes débiles de lo que queda (solo aristas entre vértices sin asignar)
+        std::vector<int> weak(n);
+        std::iota(weak.begin(), weak.end(), 0);
+        Parallel::forChunks(n, threads, detail::componentChunk, [&](std::size_t begin, std::size_t end, unsigned)
+        {
+            for (std::size_t u = begin; u < end; ++u)
+            {
+                if (scc[u] != unassigned)
+                    continue;
+                for (int v : out.neighbors(static_cast<int>(u)))
+                {
+                    if (scc[v] == unassigned)
+                        detail::link(weak, static_cast<int>(u), v);
+                }
+            }
+        });
+        detail::compress(weak, threads);
+
+        // vértices agrupados por componente débil (ordenación por conteo), grupos de mayor a menor
+        std::vector<std::size_t> offsets(n + 1, 0);
+        for (std::size_t v = 0; v < n; ++v)
+        {
+            if (scc[v] == unassigned)
+                ++offsets[weak[v] + 1];
+        }
+        std::vector<int> groups;
+        for (std::size_t r = 0; r < n; ++r)
+        {
+            if (offsets[r + 1] > 0)
+                groups.push_back(static_cast<int>(r));
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<int> members(offsets[n]);
+        {
+            std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+            for (std::size_t v = 0; v < n; ++v)
+            {
+                if (scc[v] == unassigned)
+                    members[fill[weak[v]]++] = static_cast<int>(v);
+            }
+        }
+        std::sort(groups.begin(), groups.end(), [&](int a, int b)
+        {
+            return offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b];
+        });
+
+        // Tarjan iterativo por grupo; cada grupo toca solo sus vértices, así que los
+        // vectores por vértice se comparten sin sincronización
+        std::vector<int> order(n, -1), low(n);
+        std::vector<char> onStack(n, 0);
+        std::vector<std::size_t> tarjanScanned(threads, 0);
+        Parallel::forChunks(groups.size(), threads, 1, [&](std::size_t begin, std::size_t end, unsigned tid)
+        {
+            std::vector<std::pair<int, std::size_t>> calls; // (vértice, siguiente arista)
+            std::vector<int> stack;
+            for (std::size_t g = begin; g < end; ++g)
+            {
+                const int root = groups[g];
+                int counter = 0;
+                for (std::size_t k = offsets[root]; k < offsets[root + 1]; ++k)
+                {
+                    const int start = members[k];
+                    if (order[start] >= 0)
+                        continue;
+                    order[start] = low[start] = counter++;
+                    stack.push_back(start);
+                    onStack[start] = 1;
+                    calls.emplace_back(start, 0);
+                    while (!calls.empty())
+                    {
+                        const int v = calls.back().first;
+                        const auto nbrs = out.neighbors(v);
+                        std::size_t &next = calls.back().second;
+                        if (next < nbrs.size())
+                        {
+                            const int w = nbrs[next++];
+                            if (order[w] < 0)
+                            {
+                                if (scc[w] != unassigned)
+                                    continue; // asignado en la poda o en forward-backward
+                                order[w] = low[w] = counter++;
+                                stack.push_back(w);
+                                onStack[w] = 1;
+                                calls.emplace_back(w, 0);
+                            }
+                            else if (onStack[w])
+                            {
+                                low[v] = std::min(low[v], order[w]);
+                            }
+                            continue;
+                        }
+                        if constexpr (std::remove_cvref_t<Trace>::enabled)
+                            tarjanScanned[tid] += nbrs.size();
+                        calls.pop_back();
+                        if (!calls.empty())
+                        {
+                            const int parent = calls.back().first;
+                            low[parent] = std::min(low[parent], low[v]);
+                        }
+                        if (low[v] == order[v])
+                        {
+                            int x;
+                            do
+                            {
+                                x = stack.back();
+                                stack.pop_back();
+                                onStack[x] = 0;
+                                scc[x] = v;
+                            } while (x != v);
+                        }
+                    }
+                }
+            }
+        });
+        trace.vertexSettled(n);
+        trace.edgeRelaxed(scanned);
+        for (std::size_t s : tarjanScanned)
+            trace.edgeRelaxed(s);
+        trace.phaseEnd(TracePhase::Search);
+
+        trace.phaseBegin(TracePhase::Finalize);
+        detail::relabel(scc, result);
+        trace.phaseEnd(TracePhase::Finalize);
+        return result;
+    }
+
+    // Para grafos no dirigidos, las componentes conexas; para dirigidos, las
+    // fuertemente conexas (con su traspuesto, que se construye aquí).
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    ComponentsResult Components(const CsrGraph<Weight> &g, ComponentsOptions options = {}, Trace &&trace = {})
+    {
+        if (!g.isDirected())
+            return ConnectedComponents(g, g, options, std::forward<Trace>(trace));
+        return StronglyConnectedComponents(g, g.transposed(), options, std::forward<Trace>(trace));
+    }
+} // namespace Algorithms
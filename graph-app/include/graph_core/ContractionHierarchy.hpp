@@ -0,0 +1,488 @@
+#pragma once
+#include "CsrGraph.hpp"
+#include "GraphConcepts.hpp"
+#include "ShortestPath.hpp"
+#include "VertexIndex.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Contraction hierarchy built over a weighted graph for fast s-t queries.
+ *
+ * Vertices are contracted one by one in order of importance; whenever removing
+ * a vertex v would break a shortest path u -> v -> w (no witness path of equal
+ * or smaller length avoids v) a shortcut u -> w is added. Queries run a
+ * bidirectional Dijkstra that only follows arcs towards higher-ranked vertices,
+ * which settles a tiny fraction of the graph. Shortcuts remember their middle
+ * vertex so paths can be unpacked into original edges.
+ *
+ * The index is immutable once built and records the graph version it was built
+ * from, so owners can detect when it went stale.
+ */
+template <typename Weight = double>
+class ContractionHierarchy {
+public:
+    using weight_type = Weight;
+
+    struct Options {
+        std::size_t witnessSettleLimit = 500; // settled vertices per witness search
+        std::size_t priorityWitnessSettleLimit = 40; // same, when only estimating a vertex's priority
+    };
+
+    struct Arc {
+        int node;      // target in up_, source in down_
+        Weight weight;
+        int middle;    // contracted vertex a shortcut bypasses; -1 for original edges
+    };
+
+    ContractionHierarchy() : index_(VertexIndex::empty()) {}
+
+    template <IndexedGraph G>
+    static ContractionHierarchy build(const G& g, std::uint64_t graphVersion = 0, Options options = {}) {
+        static_assert(std::is_same_v<typename G::weight_type, Weight>);
+        Builder builder(g, options);
+        ContractionHierarchy ch = builder.finish();
+        ch.index_ = g.sharedVertexIndex();
+        ch.graphVersion_ = graphVersion;
+        return ch;
+    }
+
+    std::size_t vertexCount() const { return rank_.size(); }
+    std::size_t shortcutCount() const { return shortcuts_; }
+    std::size_t arcCount() const { return up_.size() + down_.size(); }
+    std::uint64_t graphVersion() const { return graphVersion_; }
+
+    // Bytes of the index arrays; the vertex index is shared with the graph and not counted.
+    std::size_t memoryBytes() const {
+        return sizeof(*this) + rank_.capacity() * sizeof(int)
+             + (upOffsets_.capacity() + downOffsets_.capacity()) * sizeof(std::size_t)
+             + (up_.capacity() + down_.capacity()) * sizeof(Arc);
+    }
+
+    /**
+     * @brief Shortest path between two external vertex IDs.
+     *
+     * Runs a forward search over upward arcs from source and a backward search
+     * over upward arcs into target, with stall-on-demand on both sides; the
+     * backward side stops once its minimum key reaches the best meeting
+     * distance found so far. Safe to call concurrently.
+     */
+    template <TracePolicy Trace = NullTrace>
+    PathResult<Weight> query(int source, int target, Trace&& trace = {}) const {
+        constexpr Weight infinity = std::numeric_limits<Weight>::max();
+        PathResult<Weight> result;
+        result.source = source;
+        result.target = target;
+
+        trace.phaseBegin(TracePhase::Init);
+        const int s = index_->indexOf(source);
+        const int t = index_->indexOf(target);
+        if (s < 0 || t < 0) {
+            trace.phaseEnd(TracePhase::Init);
+            return result;
+        }
+        // Per-thread labels reused across queries; only touched entries are reset.
+        thread_local Labels forward, backward;
+        forward.prepare(rank_.size());
+        backward.prepare(rank_.size());
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        Weight bound = infinity;
+        upwardSearch(s, upOffsets_, up_, downOffsets_, down_, forward, nullptr, bound, trace);
+        upwardSearch(t, downOffsets_, down_, upOffsets_, up_, backward, &forward, bound, trace);
+
+        Weight mu = infinity;
+        int meet = -1;
+        for (int v : backward.touched) {
+            if (forward.dist[v] != infinity && forward.dist[v] + backward.dist[v] < mu) {
+                mu = forward.dist[v] + backward.dist[v];
+                meet = v;
+            }
+        }
+        trace.phaseEnd(TracePhase::Search);
+
+        if (meet >= 0) {
+            trace.phaseBegin(TracePhase::Finalize);
+            // Forward half: upward arcs from s to meet, collected in reverse.
+            std::vector<std::size_t> upArcs;
+            for (int v = meet; v != s; v = forward.parent[v])
+                upArcs.push_back(forward.arc[v]);
+
+            std::vector<int> path{s};
+            for (auto it = upArcs.rbegin(); it != upArcs.rend(); ++it) {
+                const int from = path.back();
+                unpack(from, up_[*it].node, up_[*it].middle, path);
+            }
+            // Backward half: meet to t; each arc lives in down_ of its endpoint closer to t.
+            for (int v = meet; v != t; v = backward.parent[v])
+                unpack(v, backward.parent[v], down_[backward.arc[v]].middle, path);
+
+            result.found = true;
+            result.cost = mu;
+            result.path.reserve(path.size());
+            for (int v : path)
+                result.path.push_back(index_->id(v));
+            trace.phaseEnd(TracePhase::Finalize);
+        }
+        forward.reset();
+        backward.reset();
+        return result;
+    }
+
+private:
+    struct Labels {
+        std::vector<Weight> dist;
+        std::vector<int> parent;      // previous vertex in the search, -1 at the start
+        std::vector<std::size_t> arc; // arc used to reach the vertex, index into up_ or down_
+        std::vector<int> touched;
+
+        void prepare(std::size_t n) {
+            if (dist.size() < n) {
+                dist.resize(n, std::numeric_limits<Weight>::max());
+                parent.resize(n, -1);
+                arc.resize(n, 0);
+            }
+        }
+
+        void reset() {
+            for (int v : touched)
+                dist[v] = std::numeric_limits<Weight>::max();
+            touched.clear();
+        }
+    };
+
+    // Dijkstra over upward arcs. A vertex is stalled (not expanded) when one
+    // of the opposite-direction arcs proves a shorter path to it. With an
+    // opposite search, bound is lowered at every settled vertex the other side
+    // reached, and the search stops once its minimum key reaches bound.
+    template <TracePolicy Trace>
+    void upwardSearch(int start, const std::vector<std::size_t>& offsets, const std::vector<Arc>& arcs,
+                      const std::vector<std::size_t>& stallOffsets, const std::vector<Arc>& stallArcs,
+                      Labels& labels, const Labels* opposite, Weight& bound, Trace& trace) const {
+        constexpr Weight infinity = std::numeric_limits<Weight>::max();
+        struct QItem {
+            Weight dist;
+            int node;
+            bool operator>(const QItem& o) const { return dist > o.dist; }
+        };
+        std::priority_queue<QItem, std::vector<QItem>, std::greater<QItem>> pq;
+        labels.dist[start] = static_cast<Weight>(0);
+        labels.parent[start] = -1;
+        labels.touched.push_back(start);
+        pq.push({static_cast<Weight>(0), start});
+        trace.heapPush(1);
+        while (!pq.empty()) {
+            auto [d, u] = pq.top();
+            pq.pop();
+            if (d != labels.dist[u]) {
+                trace.stalePop(1);
+                continue;
+            }
+            if (opposite) {
+                if (d >= bound)
+                    break;
+                if (opposite->dist[u] != infinity && d + opposite->dist[u] < bound)
+                    bound = d + opposite->dist[u];
+            }
+
+            bool stalled = false;
+            for (std::size_t k = stallOffsets[u]; k < stallOffsets[u + 1] && !stalled; ++k) {
+                const Weight dw = labels.dist[stallArcs[k].node];
+                stalled = dw != infinity && dw + stallArcs[k].weight < d;
+            }
+            if (stalled)
+                continue;
+
+            trace.vertexSettled(1);
+            for (std::size_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+                const Arc& a = arcs[k];
+                const Weight cand = d + a.weight;
+                trace.edgeRelaxed(1);
+                if (cand < labels.dist[a.node]) {
+                    if (labels.dist[a.node] == infinity)
+                        labels.touched.push_back(a.node);
+                    labels.dist[a.node] = cand;
+                    labels.parent[a.node] = u;
+                    labels.arc[a.node] = k;
+                    pq.push({cand, a.node});
+                    trace.heapPush(1);
+                }
+            }
+        }
+    }
+
+    // Appends the original vertices of arc u -> w to path, excluding u.
+    void unpack(int u, int w, int middle, std::vector<int>& path) const {
+        std::vector<std::pair<int, int>> stack{{u, w}};
+        std::vector<int> middles{middle};
+        while (!stack.empty()) {
+            auto [a, b] = stack.back();
+            int m = middles.back();
+            stack.pop_back();
+            middles.pop_back();
+            if (m < 0) {
+                path.push_back(b);
+                continue;
+            }
+            // a -> m is in down_ of m (rank[a] > rank[m]); m -> b is in up_ of m.
+            stack.push_back({m, b});
+            middles.push_back(up_[findUp(m, b)].middle);
+            stack.push_back({a, m});
+            middles.push_back(down_[findDown(a, m)].middle);
+        }
+    }
+
+    std::size_t findUp(int from, int to) const {
+        for (std::size_t k = upOffsets_[from]; k < upOffsets_[from + 1]; ++k)
+            if (up_[k].node == to) return k;
+        return up_.size();
+    }
+
+    std::size_t findDown(int from, int to) const {
+        for (std::size_t k = downOffsets_[to]; k < downOffsets_[to + 1]; ++k)
+            if (down_[k].node == from) return k;
+        return down_.size();
+    }
+
+    class Builder {
+    public:
+        template <IndexedGraph G>
+        Builder(const G& g, Options options)
+            : n_(static_cast<int>(g.vertexCount())), options_(options),
+              out_(n_), in_(n_), contracted_(n_, 0), deletedNeighbors_(n_, 0), level_(n_, 0), rank_(n_, -1), isTarget_(n_, 0),
+              dist_(n_, std::numeric_limits<Weight>::max()) {
+            for (int u = 0; u < n_; ++u) {
+                const auto nbrs = g.neighbors(u);
+                const auto wts = g.weights(u);
+                for (std::size_t k = 0; k < nbrs.size(); ++k) {
+                    if (nbrs[k] != u && wts[k] >= static_cast<Weight>(0))
+                        addArc(u, nbrs[k], wts[k], -1);
+                }
+            }
+        }
+
+        ContractionHierarchy finish() {
+            struct QItem {
+                long long priority;
+                int node;
+                bool operator>(const QItem& o) const {
+                    return priority != o.priority ? priority > o.priority : node > o.node;
+                }
+            };
+            std::priority_queue<QItem, std::vector<QItem>, std::greater<QItem>> pq;
+            std::vector<long long> current(n_);
+            for (int v = 0; v < n_; ++v) {
+                current[v] = priority(v);
+                pq.push({current[v], v});
+            }
+
+            int order = 0;
+            std::vector<Shortcut> shortcuts;
+            std::vector<int> neighbors;
+            while (!pq.empty()) {
+                auto [p, v] = pq.top();
+                pq.pop();
+                if (contracted_[v] || p != current[v])
+                    continue;
+                // Lazy update: requeue the vertex if its priority got worse.
+                current[v] = priority(v);
+                if (!pq.empty() && current[v] > pq.top().priority) {
+                    pq.push({current[v], v});
+                    continue;
+                }
+
+                shortcuts.clear();
+                findShortcuts(v, shortcuts, options_.witnessSettleLimit);
+                for (const auto& sc : shortcuts) {
+                    if (addArc(sc.from, sc.to, sc.weight, v))
+                        ++shortcutCount_;
+                }
+                contracted_[v] = 1;
+                rank_[v] = order++;
+
+                // v's remaining arcs all lead to higher-ranked vertices: they are
+                // frozen as its upward (out_) and downward (in_) arcs and dropped
+                // from the neighbors' lists so later searches skip them.
+                neighbors.clear();
+                for (const auto& a : out_[v]) {
+                    eraseArc(in_[a.node], v);
+                    neighbors.push_back(a.node);
+                }
+                for (const auto& a : in_[v]) {
+                    eraseArc(out_[a.node], v);
+                    neighbors.push_back(a.node);
+                }
+                std::sort(neighbors.begin(), neighbors.end());
+                neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+                for (int w : neighbors) {
+                    ++deletedNeighbors_[w];
+                    level_[w] = std::max(level_[w], level_[v] + 1);
+                    current[w] = priority(w);
+                    pq.push({current[w], w});
+                }
+            }
+            return assemble();
+        }
+
+    private:
+        struct Shortcut { int from; int to; Weight weight; };
+
+        static void eraseArc(std::vector<Arc>& arcs, int node) {
+            for (std::size_t k = 0; k < arcs.size(); ++k) {
+                if (arcs[k].node == node) {
+                    arcs[k] = arcs.back();
+                    arcs.pop_back();
+                    return;
+                }
+            }
+        }
+
+        // Inserts u -> w or lowers its weight; returns true for a new arc.
+        bool addArc(int u, int w, Weight weight, int middle) {
+            for (auto& a : out_[u]) {
+                if (a.node == w) {
+                    if (weight < a.weight) {
+                        a.weight = weight;
+                        a.middle = middle;
+                        for (auto& b : in_[w]) {
+                            if (b.node == u) {
+                                b.weight = weight;
+                                b.middle = middle;
+                            }
+                        }
+                    }
+                    return false;
+                }
+            }
+            out_[u].push_back({w, weight, middle});
+            in_[w].push_back({u, weight, middle});
+            return true;
+        }
+
+        long long priority(int v) {
+            std::vector<Shortcut> shortcuts;
+            findShortcuts(v, shortcuts, options_.priorityWitnessSettleLimit);
+            long long degree = static_cast<long long>(out_[v].size() + in_[v].size());
+            long long edgeDifference = static_cast<long long>(shortcuts.size()) - degree;
+            return 2 * edgeDifference + deletedNeighbors_[v] + level_[v];
+        }
+
+        // Shortcuts needed to contract v: every u -> v -> w without a witness path.
+        void findShortcuts(int v, std::vector<Shortcut>& shortcuts, std::size_t settleLimit) {
+            for (const auto& in : in_[v]) {
+                const int u = in.node;
+                Weight maxTotal = 0;
+                std::size_t targets = 0;
+                for (const auto& out : out_[v]) {
+                    if (out.node == u)
+                        continue;
+                    maxTotal = std::max(maxTotal, static_cast<Weight>(in.weight + out.weight));
+                    targets += !isTarget_[out.node];
+                    isTarget_[out.node] = 1;
+                }
+                if (targets == 0)
+                    continue;
+
+                witnessSearch(u, v, maxTotal, targets, settleLimit);
+                for (const auto& out : out_[v]) {
+                    const int w = out.node;
+                    if (w == u)
+                        continue;
+                    const Weight viaV = in.weight + out.weight;
+                    if (dist_[w] > viaV)
+                        shortcuts.push_back({u, w, viaV});
+                    isTarget_[w] = 0;
+                }
+                for (int x : touched_)
+                    dist_[x] = std::numeric_limits<Weight>::max();
+                touched_.clear();
+            }
+        }
+
+        // Local Dijkstra from u over the remaining graph, avoiding v. Stops once
+        // every target is settled, the distance limit is passed or settleLimit
+        // vertices were settled.
+        void witnessSearch(int u, int v, Weight limit, std::size_t targets, std::size_t settleLimit) {
+            struct QItem {
+                Weight dist;
+                int node;
+                bool operator>(const QItem& o) const { return dist > o.dist; }
+            };
+            std::priority_queue<QItem, std::vector<QItem>, std::greater<QItem>> pq;
+            dist_[u] = 0;
+            touched_.push_back(u);
+            pq.push({0, u});
+            std::size_t settled = 0;
+            while (!pq.empty() && settled < settleLimit) {
+                auto [d, x] = pq.top();
+                pq.pop();
+                if (d != dist_[x])
+                    continue;
+                if (d > limit)
+                    break;
+                if (isTarget_[x] && --targets == 0)
+                    break;
+                ++settled;
+                for (const auto& a : out_[x]) {
+                    if (a.node == v)
+                        continue;
+                    const Weight cand = d + a.weight;
+                    if (cand < dist_[a.node]) {
+                        if (dist_[a.node] == std::numeric_limits<Weight>::max())
+                            touched_.push_back(a.node);
+                        dist_[a.node] = cand;
+                        pq.push({cand, a.node});
+                    }
+                }
+            }
+        }
+
+        ContractionHierarchy assemble() {
+            ContractionHierarchy ch;
+            ch.rank_ = rank_;
+            ch.shortcuts_ = shortcutCount_;
+            ch.upOffsets_.assign(n_ + 1, 0);
+            ch.downOffsets_.assign(n_ + 1, 0);
+            for (int v = 0; v < n_; ++v) {
+                ch.upOffsets_[v + 1] = ch.upOffsets_[v] + out_[v].size();
+                ch.downOffsets_[v + 1] = ch.downOffsets_[v] + in_[v].size();
+            }
+            ch.up_.reserve(ch.upOffsets_[n_]);
+            ch.down_.reserve(ch.downOffsets_[n_]);
+            for (int v = 0; v < n_; ++v) {
+                ch.up_.insert(ch.up_.end(), out_[v].begin(), out_[v].end());
+                ch.down_.insert(ch.down_.end(), in_[v].begin(), in_[v].end());
+            }
+            return ch;
+        }
+
+        int n_;
+        Options options_;
+        std::vector<std::vector<Arc>> out_, in_;
+        std::vector<char> contracted_;
+        std::vector<int> deletedNeighbors_;
+        std::vector<int> level_;
+        std::vector<int> rank_;
+        std::vector<char> isTarget_;
+        std::vector<Weight> dist_;
+        std::vector<int> touched_;
+        std::size_t shortcutCount_ = 0;
+    };
+
+    std::vector<int> rank_;
+    std::vector<std::size_t> upOffsets_, downOffsets_;
+    std::vector<Arc> up_;   // arcs u -> w with rank[w] > rank[u], grouped by u
+    std::vector<Arc> down_; // arcs u -> w with rank[u] > rank[w], grouped by w (node = u)
+    std::size_t shortcuts_ = 0;
+    std::shared_ptr<const VertexIndex> index_;
+    std::uint64_t graphVersion_ = 0;
+};
@@ -0,0 +1,255 @@
+#pragma once
+#include "GraphStorage.hpp"
+#include "VertexIndex.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Immutable compressed sparse row graph.
+ *
+ * The edges of vertex u are neighbors_[offsets_[u] .. offsets_[u + 1]) with the
+ * matching weights_ entries. Vertices are dense indices; see VertexIndex for
+ * the mapping to external IDs. Satisfies IndexedGraph.
+ *
+ * The three arrays are spans over storage the graph shares ownership of:
+ * vectors it built itself, or memory owned by someone else (e.g. a mapped
+ * graph file, see view()). Copies share that storage.
+ */
+template <typename Weight = double>
+class CsrGraph {
+public:
+    using weight_type = Weight;
+
+    CsrGraph() : index_(VertexIndex::empty()) {
+        Arrays arrays;
+        arrays.offsets.assign(1, 0);
+        adopt(std::move(arrays));
+    }
+
+    explicit CsrGraph(const AdjacencyListGraph<Weight>& graph) : directed_(graph.isDirected()) {
+        const auto& adj = graph.getAdjList();
+
+        // Nodes that only appear as edge targets are vertices too.
+        std::vector<int> ids;
+        ids.reserve(adj.size());
+        for (const auto& [id, edges] : adj) {
+            ids.push_back(id);
+            for (const auto& [to, _] : edges) {
+                if (!adj.count(to))
+                    ids.push_back(to);
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        index_ = std::make_shared<const VertexIndex>(std::move(ids));
+
+        const std::size_t n = index_->size();
+        Arrays arrays;
+        arrays.offsets.assign(n + 1, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            auto it = adj.find(index_->id(static_cast<int>(u)));
+            arrays.offsets[u + 1] = arrays.offsets[u] + (it == adj.end() ? 0 : it->second.size());
+        }
+
+        arrays.neighbors.resize(arrays.offsets[n]);
+        arrays.weights.resize(arrays.offsets[n]);
+        for (std::size_t u = 0; u < n; ++u) {
+            auto it = adj.find(index_->id(static_cast<int>(u)));
+            if (it == adj.end())
+                continue;
+            std::size_t k = arrays.offsets[u];
+            for (const auto& [to, weight] : it->second) {
+                arrays.neighbors[k] = index_->indexOf(to);
+                arrays.weights[k] = weight;
+                ++k;
+            }
+        }
+        adopt(std::move(arrays));
+    }
+
+    // Vertex i of the matrix becomes vertex i (ID i) of the CSR graph.
+    explicit CsrGraph(const AdjacencyMatrixGraph<Weight>& graph) : directed_(graph.isDirected()) {
+        const std::size_t n = graph.size();
+        std::vector<int> ids(n);
+        for (std::size_t i = 0; i < n; ++i)
+            ids[i] = static_cast<int>(i);
+        index_ = std::make_shared<const VertexIndex>(std::move(ids));
+
+        Arrays arrays;
+        arrays.offsets.assign(n + 1, 0);
+        for (std::size_t i = 0; i < n; ++i)
+            arrays.offsets[i + 1] = arrays.offsets[i] + graph.degree(i);
+        arrays.neighbors.reserve(arrays.offsets[n]);
+        arrays.weights.reserve(arrays.offsets[n]);
+        for (std::size_t i = 0; i < n; ++i) {
+            graph.forEachNeighbor(i, [&](std::size_t j, Weight w) {
+                arrays.neighbors.push_back(static_cast<int>(j));
+                arrays.weights.push_back(w);
+            });
+        }
+        adopt(std::move(arrays));
+    }
+
+    /**
+     * @brief CSR graph over arrays it does not own; owner keeps them alive.
+     *
+     * offsets must hold index->size() + 1 non-decreasing entries starting at 0
+     * and ending at neighbors.size(); neighbors must be dense indices.
+     */
+    static CsrGraph view(bool directed, std::shared_ptr<const VertexIndex> index,
+                         std::span<const std::size_t> offsets, std::span<const int> neighbors,
+                         std::span<const Weight> weights, std::shared_ptr<const void> owner) {
+        CsrGraph g;
+        g.directed_ = directed;
+        g.index_ = std::move(index);
+        g.offsets_ = offsets;
+        g.neighbors_ = neighbors;
+        g.weights_ = weights;
+        g.storage_ = std::move(owner);
+        g.ownedBytes_ = 0;
+        return g;
+    }
+
+    // Same vertices with every edge reversed (incoming edges of each vertex).
+    CsrGraph transposed() const {
+        CsrGraph t;
+        t.directed_ = directed_;
+        t.index_ = index_;
+
+        const std::size_t n = vertexCount();
+        Arrays arrays;
+        arrays.offsets.assign(n + 1, 0);
+        for (int v : neighbors_)
+            ++arrays.offsets[v + 1];
+        for (std::size_t u = 0; u < n; ++u)
+            arrays.offsets[u + 1] += arrays.offsets[u];
+
+        arrays.neighbors.resize(neighbors_.size());
+        arrays.weights.resize(weights_.size());
+        std::vector<std::size_t> cursor(arrays.offsets.begin(), arrays.offsets.end() - 1);
+        for (std::size_t u = 0; u < n; ++u) {
+            for (std::size_t k = offsets_[u]; k < offsets_[u + 1]; ++k) {
+                std::size_t pos = cursor[neighbors_[k]]++;
+                arrays.neighbors[pos] = static_cast<int>(u);
+                arrays.weights[pos] = weights_[k];
+            }
+        }
+        t.adopt(std::move(arrays));
+        return t;
+    }
+
+    /**
+     * @brief Same graph with vertex order[i] moved to dense index i.
+     *
+     * Vertices keep their external IDs (the new vertex index lists them in the
+     * new order), so results of algorithms run on the permuted graph read the
+     * same through vertexId()/VertexMap. Each row is sorted by the new indices.
+     * order must be a permutation of [0, vertexCount()).
+     */
+    CsrGraph permuted(std::span<const int> order) const {
+        const std::size_t n = vertexCount();
+        std::vector<int> rank(n), ids(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            rank[order[i]] = static_cast<int>(i);
+            ids[i] = index_->id(order[i]);
+        }
+
+        CsrGraph p;
+        p.directed_ = directed_;
+        p.index_ = std::make_shared<const VertexIndex>(std::move(ids));
+
+        // Two counting-sort passes instead of sorting every row: the edges are first
+        // bucketed by new target, visiting sources in new order, and the buckets are
+        // then scattered back to their sources, which leaves each row sorted.
+        std::vector<std::size_t> bucketOffsets(n + 1, 0);
+        for (int v : neighbors_)
+            ++bucketOffsets[rank[v] + 1];
+        for (std::size_t j = 0; j < n; ++j)
+            bucketOffsets[j + 1] += bucketOffsets[j];
+        std::vector<int> sources(neighbors_.size());
+        std::vector<Weight> bucketWeights(weights_.size());
+        std::vector<std::size_t> cursor(bucketOffsets.begin(), bucketOffsets.end() - 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t k = offsets_[order[i]]; k < offsets_[order[i] + 1]; ++k) {
+                const std::size_t pos = cursor[rank[neighbors_[k]]]++;
+                sources[pos] = static_cast<int>(i);
+                bucketWeights[pos] = weights_[k];
+            }
+        }
+
+        Arrays arrays;
+        arrays.offsets.assign(n + 1, 0);
+        for (std::size_t i = 0; i < n; ++i)
+            arrays.offsets[i + 1] = arrays.offsets[i] + degree(order[i]);
+        arrays.neighbors.resize(neighbors_.size());
+        arrays.weights.resize(weights_.size());
+        cursor.assign(arrays.offsets.begin(), arrays.offsets.end() - 1);
+        for (std::size_t j = 0; j < n; ++j) {
+            for (std::size_t k = bucketOffsets[j]; k < bucketOffsets[j + 1]; ++k) {
+                const std::size_t pos = cursor[sources[k]]++;
+                arrays.neighbors[pos] = static_cast<int>(j);
+                arrays.weights[pos] = bucketWeights[k];
+            }
+        }
+        p.adopt(std::move(arrays));
+        return p;
+    }
+
+    std::size_t vertexCount() const { return offsets_.size() - 1; }
+    std::size_t edgeCount() const { return neighbors_.size(); }
+    bool isDirected() const { return directed_; }
+
+    std::size_t degree(int u) const { return offsets_[u + 1] - offsets_[u]; }
+
+    std::span<const int> neighbors(int u) const {
+        return {neighbors_.data() + offsets_[u], degree(u)};
+    }
+
+    std::span<const Weight> weights(int u) const {
+        return {weights_.data() + offsets_[u], degree(u)};
+    }
+
+    int vertexId(int u) const { return index_->id(u); }
+    int indexOf(int id) const { return index_->indexOf(id); }
+
+    const VertexIndex& vertexIndex() const { return *index_; }
+    const std::shared_ptr<const VertexIndex>& sharedVertexIndex() const { return index_; }
+
+    // Whole arrays, e.g. to write the graph out.
+    std::span<const std::size_t> offsets() const { return offsets_; }
+    std::span<const int> neighborArray() const { return neighbors_; }
+    std::span<const Weight> weightArray() const { return weights_; }
+
+    // Heap bytes of the CSR arrays; arrays viewed from other storage are not
+    // counted, and the vertex index may be shared, so it is counted apart.
+    std::size_t memoryBytes() const { return sizeof(*this) + ownedBytes_; }
+
+private:
+    struct Arrays {
+        std::vector<std::size_t> offsets;
+        std::vector<int> neighbors;
+        std::vector<Weight> weights;
+    };
+
+    void adopt(Arrays&& arrays) {
+        auto owned = std::make_shared<const Arrays>(std::move(arrays));
+        offsets_ = owned->offsets;
+        neighbors_ = owned->neighbors;
+        weights_ = owned->weights;
+        ownedBytes_ = owned->offsets.capacity() * sizeof(std::size_t)
+                    + owned->neighbors.capacity() * sizeof(int) + owned->weights.capacity() * sizeof(Weight);
+        storage_ = std::move(owned);
+    }
+
+    bool directed_ = false;
+    std::span<const std::size_t> offsets_;
+    std::span<const int> neighbors_;
+    std::span<const Weight> weights_;
+    std::shared_ptr<const void> storage_; // keeps the arrays above alive
+    std::size_t ownedBytes_ = 0;
+    std::shared_ptr<const VertexIndex> index_;
+};
@@ -0,0 +1,390 @@
+#pragma once
+#include "algorithms.hpp"
+#include "CsrGraph.hpp"
+#include "GraphConcepts.hpp"
+#include "Parallel.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Algorithms
+{
+    // ---------- Delta-stepping paralelo ----------
+    //
+    // Caminos mínimos desde un origen (Meyer y Sanders) con los vértices
+    // agrupados en cubos de anchura delta según su distancia provisional. Los
+    // hilos vacían en paralelo el cubo mínimo no vacío, relajando aristas con un
+    // compare-and-swap sobre dist; las relajaciones que caen en el mismo cubo
+    // vuelven a procesarse antes de avanzar al siguiente. Cada hilo guarda sus cubos
+    // en un anillo de ceil(peso máximo / delta) + 1 posiciones, las únicas que una
+    // relajación puede alcanzar desde el cubo actual.
+    //
+    // dist coincide con el de Dijkstra. parent se reconstruye al final con las
+    // aristas ajustadas (dist[u] + w == dist[v]) eligiendo el predecesor de menor
+    // índice denso, por lo que es un árbol de caminos mínimos válido y
+    // determinista; ante empates puede no coincidir con el de Dijkstra. Como en
+    // Dijkstra, las aristas de peso negativo se ignoran.
+
+    struct DeltaSteppingOptions
+    {
+        double delta = 0;     // anchura de cubo, acotada a los pesos del grafo; 0 = elección automática (AutoDelta)
+        unsigned threads = 0; // 0 = hardware_concurrency
+    };
+
+    namespace detail
+    {
+        // Pesos positivos del grafo: cuántos hay y entre qué valores están.
+        struct PositiveWeights
+        {
+            std::size_t count = 0;
+            double min = std::numeric_limits<double>::max();
+            double max = 0;
+        };
+
+        template <IndexedGraph G>
+        PositiveWeights positiveWeights(const G &g)
+        {
+            using Weight = typename G::weight_type;
+            PositiveWeights r;
+            for (std::size_t u = 0; u < g.vertexCount(); ++u)
+            {
+                for (Weight w : g.weights(static_cast<int>(u)))
+                {
+                    double dw = static_cast<double>(w);
+                    if (dw <= 0)
+                        continue;
+                    ++r.count;
+                    r.max = std::max(r.max, dw);
+                    r.min = std::min(r.min, dw);
+                }
+            }
+            return r;
+        }
+
+        // Una relajación cae como mucho ceil(peso máximo / delta) cubos por delante del
+        // actual, así que basta un anillo de ese número de cubos más uno. delta no baja de
+        // peso máximo / maxBuckets, lo que acota el anillo y el índice de cubo absoluto
+        // (distancia / delta, menor que vértices * maxBuckets).
+        inline constexpr double maxBuckets = 4096;
+
+        // delta acotado entre el menor peso positivo y el mayor, y no por debajo de
+        // peso máximo / maxBuckets; con pesos enteros, también entero.
+        template <typename Weight>
+        double clampDelta(const PositiveWeights &weights, double delta)
+        {
+            if (weights.count == 0)
+                return 1;
+            delta = std::clamp(delta, weights.min, weights.max);
+            double lowest = weights.max / maxBuckets;
+            if constexpr (std::is_integral_v<Weight>)
+            {
+                delta = std::max(1.0, std::floor(delta));
+                lowest = std::ceil(lowest);
+            }
+            return std::max(delta, lowest);
+        }
+
+        template <typename Weight>
+        double autoDelta(const PositiveWeights &weights, std::size_t vertexCount)
+        {
+            double avgDegree = static_cast<double>(weights.count) / static_cast<double>(std::max<std::size_t>(1, vertexCount));
+            return clampDelta<Weight>(weights, weights.max / std::max(1.0, avgDegree));
+        }
+
+        // Cubos del anillo para esta delta.
+        inline std::size_t bucketSlots(const PositiveWeights &weights, double delta)
+        {
+            return static_cast<std::size_t>(std::ceil(weights.max / delta)) + 1;
+        }
+    } // namespace detail
+
+    // delta ~ peso máximo / grado medio (Meyer y Sanders), acotado entre el menor
+    // peso positivo y el peso máximo (y no por debajo de peso máximo / detail::maxBuckets).
+    template <IndexedGraph G>
+    double AutoDelta(const G &g)
+    {
+        return detail::autoDelta<typename G::weight_type>(detail::positiveWeights(g), g.vertexCount());
+    }
+
+    // delta de las opciones acotado al mismo rango que AutoDelta: más estrecho que el menor
+    // peso solo añade cubos vacíos, y más ancho que el mayor no cambia nada. Un valor que no
+    // sea positivo (o NaN) deja la elección a AutoDelta.
+    template <IndexedGraph G>
+    double ResolveDelta(const G &g, double requested)
+    {
+        const auto weights = detail::positiveWeights(g);
+        return requested > 0 ? detail::clampDelta<typename G::weight_type>(weights, requested)
+                             : detail::autoDelta<typename G::weight_type>(weights, g.vertexCount());
+    }
+
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    DijkstraResult<typename G::weight_type> DeltaStepping(const G &g, int source, DeltaSteppingOptions options = {},
+                                                          Trace &&trace = {})
+    {
+        using Weight = typename G::weight_type;
+        constexpr Weight infinity = std::numeric_limits<Weight>::max();
+        constexpr std::size_t chunkSize = 256;
+        constexpr std::size_t noBucket = std::numeric_limits<std::size_t>::max();
+
+        constexpr bool tracing = std::remove_cvref_t<Trace>::enabled;
+
+        DijkstraResult<Weight> r;
+        r.source = source;
+
+        trace.phaseBegin(TracePhase::Init);
+        const std::size_t n = g.vertexCount();
+        r.dist = VertexMap<Weight>(g.sharedVertexIndex(), infinity);
+        r.parent = VertexMap<int>(g.sharedVertexIndex(), -1);
+        auto &dist = r.dist.dense();
+        auto &parent = r.parent.dense();
+
+        const int s = g.indexOf(source);
+        if (s < 0)
+        {
+            trace.phaseEnd(TracePhase::Init);
+            return r;
+        }
+
+        // Los cubos forman un anillo: el cubo absoluto b vive en bins[b % slots]
+        const auto weights = detail::positiveWeights(g);
+        const double deltaValue = options.delta > 0 ? detail::clampDelta<Weight>(weights, options.delta)
+                                                    : detail::autoDelta<Weight>(weights, n);
+        const Weight delta = static_cast<Weight>(deltaValue);
+        const std::size_t slots = detail::bucketSlots(weights, deltaValue);
+        auto bucketOf = [delta](Weight d) { return static_cast<std::size_t>(d / delta); };
+
+        const unsigned threads = Parallel::threadsFor(n, options.threads, 4096);
+
+        dist[s] = static_cast<Weight>(0);
+        std::vector<int> frontier{s};
+        std::size_t bucket = 0;
+        bool done = false;
+        std::atomic<std::size_t> cursor{0};
+
+        struct alignas(64) ThreadState
+        {
+            std::vector<std::vector<int>> bins; // anillo de `slots` cubos
+            std::size_t pending = 0;            // vértices en bins
+            std::size_t nextBucket = 0;
+            std::size_t offset = 0;
+            std::size_t settled = 0, relaxed = 0, pushes = 0, stale = 0; // solo con Trace::enabled
+        };
+        std::vector<ThreadState> state(threads);
+        for (auto &st : state)
+            st.bins.resize(slots);
+
+        // Un hilo que falla (p. ej. bad_alloc al crecer un cubo) no puede salir sin más: los
+        // demás lo esperan en las barreras. Lo anota aquí y todos salen en la siguiente elección.
+        Parallel::FirstError error;
+        bool cancelled = false;
+
+        auto onBucketChosen = [&]() noexcept
+        {
+            std::size_t next = noBucket;
+            for (const auto &st : state)
+                next = std::min(next, st.nextBucket);
+            if (next == noBucket || error.failed())
+            {
+                done = true;
+                return;
+            }
+            if (trace.cancelRequested())
+            {
+                cancelled = true;
+                done = true;
+                return;
+            }
+            bucket = next;
+            std::size_t total = 0;
+            for (auto &st : state)
+            {
+                st.offset = total;
+                total += st.bins[bucket % slots].size();
+            }
+            try
+            {
+                frontier.resize(total);
+            }
+            catch (...)
+            {
+                error.capture();
+                done = true;
+            }
+            cursor.store(0, std::memory_order_relaxed);
+        };
+        std::barrier chooseSync(static_cast<std::ptrdiff_t>(threads), onBucketChosen);
+        std::barrier copySync(static_cast<std::ptrdiff_t>(threads));
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        Parallel::run(threads, [&](unsigned tid)
+        {
+            ThreadState &st = state[tid];
+            auto relax = [&](int u)
+            {
+                const Weight du = std::atomic_ref<Weight>(dist[u]).load(std::memory_order_relaxed);
+                if (bucketOf(du) < bucket)
+                {
+                    if constexpr (tracing)
+                        ++st.stale;
+                    return; // ya procesado en un cubo anterior
+                }
+                const auto nbrs = g.neighbors(u);
+                const auto wts = g.weights(u);
+                if constexpr (tracing)
+                {
+                    ++st.settled;
+                    st.relaxed += nbrs.size();
+                }
+                for (std::size_t k = 0; k < nbrs.size(); ++k)
+                {
+                    const Weight w = wts[k];
+                    if (w < static_cast<Weight>(0))
+                        continue;
+                    const int v = nbrs[k];
+                    const Weight cand = du + w;
+                    std::atomic_ref<Weight> dv(dist[v]);
+                    Weight old = dv.load(std::memory_order_relaxed);
+                    while (cand < old)
+                    {
+                        if (dv.compare_exchange_weak(old, cand, std::memory_order_relaxed))
+                        {
+                            st.bins[bucketOf(cand) % slots].push_back(v);
+                            ++st.pending;
+                            if constexpr (tracing)
+                                ++st.pushes;
+                            break;
+                        }
+                    }
+                }
+            };
+
+            while (!done)
+            {
+                try
+                {
+                    for (std::size_t c = cursor.fetch_add(chunkSize, std::memory_order_relaxed); c < frontier.size();
+                         c = cursor.fetch_add(chunkSize, std::memory_order_relaxed))
+                    {
+                        const std::size_t end = std::min(frontier.size(), c + chunkSize);
+                        for (std::size_t i = c; i < end; ++i)
+                            relax(frontier[i]);
+                    }
+                }
+                catch (...)
+                {
+                    error.capture();
+                }
+
+                // primer cubo no vacío del anillo a partir del actual
+                st.nextBucket = noBucket;
+                for (std::size_t k = 0; st.pending > 0 && k < slots; ++k)
+                {
+                    if (!st.bins[(bucket + k) % slots].empty())
+                    {
+                        st.nextBucket = bucket + k;
+                        break;
+                    }
+                }
+                chooseSync.arrive_and_wait();
+                if (done)
+                    break;
+
+                auto &bin = st.bins[bucket % slots];
+                std::copy(bin.begin(), bin.end(), frontier.begin() + st.offset);
+                st.pending -= bin.size();
+                bin.clear();
+                copySync.arrive_and_wait();
+            }
+        });
+        error.rethrow();
+        if (cancelled)
+            throw OperationCancelled();
+        if constexpr (tracing)
+        {
+            for (const auto &st : state)
+            {
+                trace.vertexSettled(st.settled);
+                trace.edgeRelaxed(st.relaxed);
+                trace.heapPush(st.pushes);
+                trace.stalePop(st.stale);
+            }
+        }
+        trace.phaseEnd(TracePhase::Search);
+
+        trace.phaseBegin(TracePhase::Finalize);
+        // parent: predecesor de menor índice denso entre las aristas ajustadas de peso positivo
+        std::vector<int> best(n, std::numeric_limits<int>::max());
+        Parallel::run(threads, [&](unsigned tid)
+        {
+            auto [begin, end] = Parallel::block(n, tid, threads);
+            for (std::size_t u = begin; u < end; ++u)
+            {
+                if (dist[u] == infinity)
+                    continue;
+                const auto nbrs = g.neighbors(static_cast<int>(u));
+                const auto wts = g.weights(static_cast<int>(u));
+                for (std::size_t k = 0; k < nbrs.size(); ++k)
+                {
+                    const int v = nbrs[k];
+                    if (v == s || wts[k] <= static_cast<Weight>(0) || dist[u] + wts[k] != dist[v])
+                        continue;
+                    std::atomic_ref<int> bv(best[v]);
+                    int cur = bv.load(std::memory_order_relaxed);
+                    while (static_cast<int>(u) < cur && !bv.compare_exchange_weak(cur, static_cast<int>(u), std::memory_order_relaxed))
+                    {
+                    }
+                }
+            }
+        });
+
+        // los vértices alcanzados solo por aristas de peso cero cuelgan de un vecino con padre
+        std::vector<int> pending;
+        for (std::size_t v = 0; v < n; ++v)
+            if (dist[v] != infinity && static_cast<int>(v) != s && best[v] == std::numeric_limits<int>::max())
+                pending.push_back(static_cast<int>(v));
+        if (!pending.empty())
+        {
+            std::vector<int> queue;
+            for (std::size_t u = 0; u < n; ++u)
+                if (static_cast<int>(u) == s || best[u] != std::numeric_limits<int>::max())
+                    queue.push_back(static_cast<int>(u));
+            for (std::size_t head = 0; head < queue.size(); ++head)
+            {
+                const int u = queue[head];
+                const auto nbrs = g.neighbors(u);
+                const auto wts = g.weights(u);
+                for (std::size_t k = 0; k < nbrs.size(); ++k)
+                {
+                    const int v = nbrs[k];
+                    if (wts[k] == static_cast<Weight>(0) && v != s && dist[v] == dist[u] &&
+                        best[v] == std::numeric_limits<int>::max())
+                    {
+                        best[v] = u;
+                        queue.push_back(v);
+                    }
+                }
+            }
+        }
+
+        for (std::size_t v = 0; v < n; ++v)
+            if (best[v] != std::numeric_limits<int>::max())
+                parent[v] = g.vertexId(best[v]);
+        trace.phaseEnd(TracePhase::Finalize);
+        return r;
+    }
+
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    DijkstraResult<Weight> DeltaStepping(const AdjacencyListGraph<Weight> &g, int source, DeltaSteppingOptions options = {},
+                                         Trace &&trace = {})
+    {
+        return DeltaStepping(CsrGraph<Weight>(g), source, options, std::forward<Trace>(trace));
+    }
+} // namespace Algorithms
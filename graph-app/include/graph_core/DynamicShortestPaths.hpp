@@ -0,0 +1,325 @@
+#pragma once
+#include "algorithms.hpp"
+#include "CsrGraph.hpp"
+#include "GraphStorage.hpp"
+#include "Trace.hpp"
+#include "VertexIndex.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Single-source shortest paths kept up to date under batches of edge changes.
+ *
+ * Holds its own copy of the graph's arcs, outgoing and incoming, and the
+ * shortest-path tree from one source. apply() edits the arcs and then repairs
+ * only the part of the tree the batch affects (Ramalingam-Reps style):
+ *  - when the arcs u -> v under a tree edge get longer or disappear, the
+ *    subtree below v is detached: its vertices lose their distance and are
+ *    re-seeded from their in-neighbours outside the subtree;
+ *  - when arcs u -> v now offer a shorter path to v, v is seeded with it;
+ * and a Dijkstra from the seeds settles just the vertices whose distance
+ * changes. The work is proportional to the affected region and its arcs, not
+ * to the graph.
+ *
+ * Distances always equal those of a full Dijkstra; among equally short paths
+ * the chosen parents may differ. Negative weights are ignored, as in Dijkstra.
+ * Vertices are never removed (one that loses its edges stays, unreachable),
+ * and removing or reweighting an edge that does not exist is a no-op. Not
+ * thread-safe.
+ */
+template <typename Weight = double>
+class DynamicShortestPaths {
+public:
+    using weight_type = Weight;
+    using Change = EdgeChange<Weight>;
+
+    struct UpdateStats {
+        std::size_t detached = 0; // vertices whose tree path was cut
+        std::size_t changed = 0;  // vertices whose distance changed
+    };
+
+    // Copies the arcs of graph and runs a full Dijkstra from source, which may be absent.
+    DynamicShortestPaths(const CsrGraph<Weight>& graph, int source)
+        : source_(source), directed_(graph.isDirected()) {
+        const std::size_t n = graph.vertexCount();
+        ids_.reserve(n);
+        lookup_.reserve(n);
+        for (std::size_t u = 0; u < n; ++u)
+            addVertex(graph.vertexId(static_cast<int>(u)));
+        for (std::size_t u = 0; u < n; ++u) {
+            const auto neighbors = graph.neighbors(static_cast<int>(u));
+            const auto weights = graph.weights(static_cast<int>(u));
+            out_[u].reserve(neighbors.size());
+            for (std::size_t k = 0; k < neighbors.size(); ++k) {
+                out_[u].push_back({neighbors[k], weights[k]});
+                in_[neighbors[k]].push_back({static_cast<int>(u), weights[k]});
+            }
+        }
+        ++epoch_;
+        if (const int s = indexOf(source); s >= 0)
+            seed(s);
+        settle(NullTrace{});
+    }
+
+    /**
+     * @brief Applies a batch of edge changes, with the semantics of applyEdgeChanges(),
+     * and repairs the distances.
+     */
+    template <TracePolicy Trace = NullTrace>
+    UpdateStats apply(std::span<const Change> changes, Trace&& trace = {}) {
+        UpdateStats stats;
+        ++epoch_;
+        touched_.clear();
+
+        trace.phaseBegin(TracePhase::Init);
+        // pairs (u, v) whose arcs changed, checked once the whole batch is in
+        std::vector<std::pair<int, int>> pairs;
+        pairs.reserve(changes.size() * (directed_ ? 1 : 2));
+        for (const auto& change : changes) {
+            const int u = vertex(change.from), v = vertex(change.to);
+            editArcs(change, u, v);
+            pairs.emplace_back(u, v);
+            if (!directed_ && u != v) {
+                editArcs(change, v, u);
+                pairs.emplace_back(v, u);
+            }
+        }
+
+        // tree edges that got longer or vanished: detach the subtrees below them
+        std::vector<int> detached;
+        for (auto [u, v] : pairs) {
+            if (parent_[v] != u || detachedAt_[v] == epoch_)
+                continue;
+            const Weight w = shortestArc(u, v);
+            if (w == infinity || dist_[u] == infinity || dist_[u] + w > dist_[v])
+                detach(v, detached);
+        }
+        stats.detached = detached.size();
+
+        // detached vertices restart from their neighbours outside the subtree; changed arcs
+        // may shorten a path anywhere
+        for (int v : detached) {
+            for (const Arc& arc : in_[v]) {
+                if (detachedAt_[arc.node] != epoch_ && dist_[arc.node] != infinity)
+                    relax(arc.node, v, arc.weight, trace);
+            }
+        }
+        for (auto [u, v] : pairs) {
+            if (dist_[u] != infinity) {
+                if (const Weight w = shortestArc(u, v); w != infinity)
+                    relax(u, v, w, trace);
+            }
+        }
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        settle(trace);
+        trace.phaseEnd(TracePhase::Search);
+
+        for (auto [v, old] : touched_) {
+            if (dist_[v] != old)
+                ++stats.changed;
+        }
+        return stats;
+    }
+
+    int source() const { return source_; }
+    bool isDirected() const { return directed_; }
+    std::size_t vertexCount() const { return ids_.size(); }
+
+    // Distance to node id; max() if it is unreachable or unknown.
+    Weight distance(int id) const {
+        const int v = indexOf(id);
+        return v < 0 ? infinity : dist_[v];
+    }
+
+    // Current distances and parents, in the same form Algorithms::Dijkstra returns.
+    DijkstraResult<Weight> result() const {
+        if (!index_ || index_->size() != ids_.size())
+            index_ = std::make_shared<const VertexIndex>(ids_);
+        DijkstraResult<Weight> r;
+        r.source = source_;
+        r.dist = VertexMap<Weight>(index_, infinity);
+        r.parent = VertexMap<int>(index_, -1);
+        r.dist.dense() = dist_;
+        for (std::size_t v = 0; v < ids_.size(); ++v) {
+            if (parent_[v] >= 0)
+                r.parent.dense()[v] = ids_[parent_[v]];
+        }
+        return r;
+    }
+
+    std::size_t memoryBytes() const {
+        std::size_t bytes = sizeof(*this) + ids_.capacity() * sizeof(int)
+                          + lookup_.bucket_count() * sizeof(void*)
+                          + lookup_.size() * (sizeof(void*) + sizeof(std::pair<const int, int>))
+                          + dist_.capacity() * sizeof(Weight) + parent_.capacity() * sizeof(int)
+                          + (touchedAt_.capacity() + detachedAt_.capacity()) * sizeof(std::uint32_t)
+                          + (out_.capacity() + in_.capacity()) * sizeof(std::vector<Arc>);
+        for (std::size_t v = 0; v < out_.size(); ++v)
+            bytes += (out_[v].capacity() + in_[v].capacity()) * sizeof(Arc);
+        return bytes;
+    }
+
+private:
+    static constexpr Weight infinity = std::numeric_limits<Weight>::max();
+
+    struct Arc {
+        int node; // target in out_, source in in_
+        Weight weight;
+    };
+
+    struct QItem {
+        Weight dist;
+        int node;
+        bool operator>(const QItem& other) const { return dist > other.dist; }
+    };
+
+    int indexOf(int id) const {
+        auto it = lookup_.find(id);
+        return it == lookup_.end() ? -1 : it->second;
+    }
+
+    int addVertex(int id) {
+        const int v = static_cast<int>(ids_.size());
+        ids_.push_back(id);
+        lookup_.emplace(id, v);
+        out_.emplace_back();
+        in_.emplace_back();
+        dist_.push_back(infinity);
+        parent_.push_back(-1);
+        touchedAt_.push_back(0);
+        detachedAt_.push_back(0);
+        return v;
+    }
+
+    // Dense index of node id, created if new; the source starts its own tree when it appears.
+    int vertex(int id) {
+        if (const int v = indexOf(id); v >= 0)
+            return v;
+        const int v = addVertex(id);
+        if (id == source_)
+            seed(v);
+        return v;
+    }
+
+    void editArcs(const Change& change, int u, int v) {
+        switch (change.kind) {
+            case Change::Kind::Insert:
+                out_[u].push_back({v, change.weight});
+                in_[v].push_back({u, change.weight});
+                break;
+            case Change::Kind::Remove:
+                std::erase_if(out_[u], [v](const Arc& arc) { return arc.node == v; });
+                std::erase_if(in_[v], [u](const Arc& arc) { return arc.node == u; });
+                break;
+            case Change::Kind::SetWeight:
+                for (Arc& arc : out_[u]) {
+                    if (arc.node == v)
+                        arc.weight = change.weight;
+                }
+                for (Arc& arc : in_[v]) {
+                    if (arc.node == u)
+                        arc.weight = change.weight;
+                }
+                break;
+        }
+    }
+
+    // Lightest usable arc u -> v; infinity if there is none.
+    Weight shortestArc(int u, int v) const {
+        Weight best = infinity;
+        for (const Arc& arc : out_[u]) {
+            if (arc.node == v && arc.weight >= Weight{0} && arc.weight < best)
+                best = arc.weight;
+        }
+        return best;
+    }
+
+    // Remembers v's distance before this update, once.
+    void touch(int v) {
+        if (touchedAt_[v] != epoch_) {
+            touchedAt_[v] = epoch_;
+            touched_.emplace_back(v, dist_[v]);
+        }
+    }
+
+    void seed(int s) {
+        touch(s);
+        dist_[s] = Weight{0};
+        parent_[s] = -1;
+        heap_.push({dist_[s], s});
+    }
+
+    // Clears the distances of root's subtree in the shortest-path tree.
+    void detach(int root, std::vector<int>& detached) {
+        std::vector<int> stack{root};
+        detachedAt_[root] = epoch_;
+        while (!stack.empty()) {
+            const int x = stack.back();
+            stack.pop_back();
+            for (const Arc& arc : out_[x]) {
+                if (parent_[arc.node] == x && detachedAt_[arc.node] != epoch_) {
+                    detachedAt_[arc.node] = epoch_;
+                    stack.push_back(arc.node);
+                }
+            }
+            touch(x);
+            dist_[x] = infinity;
+            parent_[x] = -1;
+            detached.push_back(x);
+        }
+    }
+
+    template <typename Trace>
+    void relax(int u, int v, Weight w, Trace& trace) {
+        if (w < Weight{0})
+            return; // peso negativo, se ignora
+        trace.edgeRelaxed(1);
+        const Weight cand = dist_[u] + w;
+        if (cand < dist_[v]) {
+            touch(v);
+            dist_[v] = cand;
+            parent_[v] = u;
+            heap_.push({cand, v});
+            trace.heapPush(1);
+        }
+    }
+
+    template <typename Trace>
+    void settle(Trace&& trace) {
+        while (!heap_.empty()) {
+            const auto [du, u] = heap_.top();
+            heap_.pop();
+            if (du != dist_[u]) {
+                trace.stalePop(1);
+                continue;
+            }
+            trace.vertexSettled(1);
+            for (const Arc& arc : out_[u])
+                relax(u, arc.node, arc.weight, trace);
+        }
+    }
+
+    int source_;
+    bool directed_;
+    std::vector<int> ids_; // external ID of each dense index
+    std::unordered_map<int, int> lookup_;
+    std::vector<std::vector<Arc>> out_, in_;
+    std::vector<Weight> dist_;
+    std::vector<int> parent_; // dense index of the parent, or -1
+    // per-update bookkeeping: a vertex is marked when its entry equals epoch_
+    std::uint32_t epoch_ = 0;
+    std::vector<std::uint32_t> touchedAt_, detachedAt_;
+    std::vector<std::pair<int, Weight>> touched_; // (vertex, distance before the update)
+    std::priority_queue<QItem, std::vector<QItem>, std::greater<QItem>> heap_;
+    mutable std::shared_ptr<const VertexIndex> index_; // of result(), rebuilt when vertices are added
+};
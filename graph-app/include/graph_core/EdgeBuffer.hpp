@@ -0,0 +1,124 @@
+#pragma once
+#include "GraphStorage.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Append-only edge list stored in fixed-size blocks.
+ *
+ * Appending never moves the edges already stored, so a list of tens of
+ * millions of edges grows without the reallocation copies (and the transient
+ * 2x peak) of one big std::vector. drain() releases each block once it has
+ * been consumed, so building a graph from the buffer does not hold both in
+ * full at the same time.
+ */
+template<typename Weight = double>
+class EdgeBuffer {
+public:
+    struct Edge {
+        int from;
+        int to;
+        Weight weight;
+    };
+
+    static constexpr std::size_t blockEdges = std::size_t{1} << 16;
+
+    void push(int from, int to, Weight weight) {
+        if (blocks_.empty() || blocks_.back().size() == blockEdges) {
+            blocks_.emplace_back();
+            blocks_.back().reserve(blockEdges);
+        }
+        blocks_.back().push_back({from, to, weight});
+        ++size_;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    template<typename F>
+    void forEach(F&& f) const {
+        for (const auto& block : blocks_)
+            for (const auto& e : block)
+                f(e);
+    }
+
+    // Visits every edge in order, freeing each block after visiting it; leaves the buffer empty.
+    template<typename F>
+    void drain(F&& f) {
+        for (auto& block : blocks_) {
+            for (const auto& e : block)
+                f(e);
+            std::vector<Edge>().swap(block);
+        }
+        blocks_.clear();
+        size_ = 0;
+    }
+
+    std::size_t memoryBytes() const {
+        return sizeof(*this) + blocks_.capacity() * sizeof(std::vector<Edge>) + blocks_.size() * blockEdges * sizeof(Edge);
+    }
+
+private:
+    std::vector<std::vector<Edge>> blocks_;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Builds an adjacency list in bulk, with the same contents as addNode()
+ * for every node followed by addEdge() for every edge, in order.
+ *
+ * A first pass buckets the edges by endpoint to count degrees, so every
+ * adjacency vector (and the node table) is allocated once at its final size;
+ * the second pass fills them while draining the buffer.
+ */
+template<typename Weight>
+AdjacencyListGraph<Weight> buildAdjacencyList(bool directed, const std::vector<std::pair<int, std::string>>& nodes,
+                                              EdgeBuffer<Weight>&& edges) {
+    std::unordered_map<int, std::size_t> degree;
+    degree.reserve(nodes.size());
+    for (const auto& [id, label] : nodes)
+        degree[id];
+    edges.forEach([&](const auto& e) {
+        ++degree[e.from];
+        if (!directed && e.from != e.to)
+            ++degree[e.to];
+    });
+
+    AdjacencyListGraph<Weight> graph(directed);
+    graph.reserve(degree.size());
+    for (const auto& [id, count] : degree)
+        graph.reserveEdges(id, count);
+    std::unordered_map<int, std::size_t>().swap(degree);
+
+    for (const auto& [id, label] : nodes)
+        graph.addNode(id, label);
+    edges.drain([&](const auto& e) { graph.addEdge(e.from, e.to, e.weight); });
+    return graph;
+}
+
+// Adjacency matrix of n vertices from a node/edge list; throws std::out_of_range on IDs outside [0, n).
+template<typename Weight>
+AdjacencyMatrixGraph<Weight> buildAdjacencyMatrix(std::size_t n, bool directed,
+                                                  const std::vector<std::pair<int, std::string>>& nodes,
+                                                  EdgeBuffer<Weight>&& edges) {
+    auto check = [n](int id) {
+        if (id < 0 || static_cast<std::size_t>(id) >= n)
+            throw std::out_of_range("Vertex " + std::to_string(id) + " outside matrix of size " + std::to_string(n));
+    };
+
+    AdjacencyMatrixGraph<Weight> graph(n, directed);
+    for (const auto& [id, label] : nodes) {
+        check(id);
+        graph.addNode(id, label);
+    }
+    edges.drain([&](const auto& e) {
+        check(e.from);
+        check(e.to);
+        graph.addEdge(e.from, e.to, e.weight);
+    });
+    return graph;
+}
@@ -0,0 +1,214 @@
+#pragma once
+#include "GraphStorage.hpp"
+#include "Parallel.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ---------- Resultado de caminos mínimos entre todos los pares ----------
+
+template <typename Weight>
+struct AllPairsResult
+{
+    static constexpr Weight infinity = std::numeric_limits<Weight>::max(); // sin camino
+
+    std::size_t size = 0;
+    std::vector<Weight> dist; // fila a fila: dist[i * size + j]
+    bool negativeCycle = false;
+
+    Weight at(std::size_t i, std::size_t j) const { return dist[i * size + j]; }
+};
+
+namespace Algorithms
+{
+    // ---------- Floyd–Warshall por bloques ----------
+    //
+    // La matriz de distancias se divide en bloques de tileSize x tileSize. Para
+    // cada bloque diagonal kb hay tres fases:
+    //   1. el bloque (kb, kb) se cierra sobre sí mismo;
+    //   2. los bloques de la fila kb y de la columna kb se actualizan con él;
+    //   3. el resto de bloques (i, j) hace min-plus con (i, kb) y (kb, j).
+    // Dentro de cada fase los bloques son independientes y se reparten entre
+    // hilos. El núcleo recorre j sobre filas contiguas con un mínimo sin saltos,
+    // que el compilador vectoriza.
+    //
+    // Los pesos negativos están permitidos; si aparece un ciclo negativo (algún
+    // dist[i][i] < 0) se marca negativeCycle y las distancias afectadas no son
+    // significativas. Con pesos enteros el "infinito" interno es max / 2 para que
+    // la suma no desborde, así que los costes de los caminos deben quedar muy por
+    // debajo de max / 4.
+
+    struct FloydWarshallOptions
+    {
+        unsigned threads = 0;       // 0 = hardware_concurrency
+        std::size_t tileSize = 64;  // lado del bloque; 3 bloques deben caber en caché
+    };
+
+    namespace detail
+    {
+        // C[i][j] = min(C[i][j], A[i][k] + B[k][j]) para k, i, j del bloque. Válido
+        // también cuando C coincide con A o con B (fases 1 y 2).
+        template <typename Weight>
+        void minPlusTile(Weight *c, const Weight *a, const Weight *b, std::size_t tile, std::size_t stride)
+        {
+            for (std::size_t k = 0; k < tile; ++k)
+            {
+                const Weight *bk = b + k * stride;
+                for (std::size_t i = 0; i < tile; ++i)
+                {
+                    const Weight aik = a[i * stride + k];
+                    Weight *ci = c + i * stride;
+                    for (std::size_t j = 0; j < tile; ++j)
+                    {
+                        const Weight cand = aik + bk[j];
+                        ci[j] = cand < ci[j] ? cand : ci[j];
+                    }
+                }
+            }
+        }
+
+        // Fase 3: C no se solapa con A ni con B, así que el núcleo puede declararlo
+        // y el compilador vectoriza el bucle j sin comprobaciones de alias. Sin
+        // dependencias entre k, el orden i-k-j mantiene la fila de C en caché.
+        template <typename Weight>
+        void minPlusTileDisjoint(Weight *__restrict c, const Weight *__restrict a, const Weight *__restrict b,
+                                 std::size_t tile, std::size_t stride)
+        {
+            for (std::size_t i = 0; i < tile; ++i)
+            {
+                Weight *__restrict ci = c + i * stride;
+                for (std::size_t k = 0; k < tile; ++k)
+                {
+                    const Weight aik = a[i * stride + k];
+                    const Weight *__restrict bk = b + k * stride;
+                    for (std::size_t j = 0; j < tile; ++j)
+                    {
+                        const Weight cand = aik + bk[j];
+                        ci[j] = cand < ci[j] ? cand : ci[j];
+                    }
+                }
+            }
+        }
+    } // namespace detail
+
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    AllPairsResult<Weight> FloydWarshall(const AdjacencyMatrixGraph<Weight> &g, FloydWarshallOptions options = {},
+                                         Trace &&trace = {})
+    {
+        constexpr Weight internalInfinity = std::is_floating_point_v<Weight>
+                                                ? std::numeric_limits<Weight>::infinity()
+                                                : std::numeric_limits<Weight>::max() / 2;
+
+        AllPairsResult<Weight> r;
+        trace.phaseBegin(TracePhase::Init);
+        const std::size_t n = g.size();
+        r.size = n;
+        if (n == 0)
+        {
+            trace.phaseEnd(TracePhase::Init);
+            return r;
+        }
+
+        // matriz de trabajo rellenada hasta un múltiplo del bloque
+        const std::size_t tile = std::max<std::size_t>(1, std::min(options.tileSize, n));
+        const std::size_t blocks = (n + tile - 1) / tile;
+        const std::size_t stride = blocks * tile;
+        std::vector<Weight> d(stride * stride, internalInfinity);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            Weight *row = d.data() + i * stride;
+            g.forEachNeighbor(i, [&](std::size_t j, Weight w) { row[j] = w; });
+            row[i] = std::min(row[i], static_cast<Weight>(0));
+        }
+        for (std::size_t i = n; i < stride; ++i)
+            d[i * stride + i] = static_cast<Weight>(0);
+
+        const unsigned threads = Parallel::threadsFor(blocks * blocks, options.threads, 4);
+        // cada barrera toma la marca de cancelación una vez, para todos los hilos a la vez
+        bool cancelled = false;
+        std::barrier sync(static_cast<std::ptrdiff_t>(threads), [&]() noexcept { cancelled = trace.cancelRequested(); });
+        auto tileAt = [&](std::size_t bi, std::size_t bj) { return d.data() + bi * tile * stride + bj * tile; };
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        Parallel::run(threads, [&](unsigned tid)
+        {
+            for (std::size_t kb = 0; kb < blocks; ++kb)
+            {
+                Weight *diag = tileAt(kb, kb);
+                if (tid == 0)
+                    detail::minPlusTile(diag, diag, diag, tile, stride);
+                sync.arrive_and_wait();
+
+                // fase 2: índice t < blocks -> fila kb, si no -> columna kb
+                for (std::size_t t = tid; t < 2 * blocks; t += threads)
+                {
+                    const std::size_t b = t % blocks;
+                    if (b == kb)
+                        continue;
+                    if (t < blocks)
+                    {
+                        Weight *c = tileAt(kb, b);
+                        detail::minPlusTile(c, diag, c, tile, stride);
+                    }
+                    else
+                    {
+                        Weight *c = tileAt(b, kb);
+                        detail::minPlusTile(c, c, diag, tile, stride);
+                    }
+                }
+                sync.arrive_and_wait();
+
+                for (std::size_t t = tid; t < blocks * blocks; t += threads)
+                {
+                    const std::size_t bi = t / blocks, bj = t % blocks;
+                    if (bi == kb || bj == kb)
+                        continue;
+                    detail::minPlusTileDisjoint(tileAt(bi, bj), tileAt(bi, kb), tileAt(kb, bj), tile, stride);
+                }
+                sync.arrive_and_wait();
+                if (cancelled)
+                    break;
+            }
+        });
+        if (cancelled)
+            throw OperationCancelled();
+        if constexpr (std::remove_cvref_t<Trace>::enabled)
+        {
+            trace.vertexSettled(n);
+            trace.edgeRelaxed(stride * stride * stride);
+        }
+        trace.phaseEnd(TracePhase::Search);
+
+        trace.phaseBegin(TracePhase::Finalize);
+        r.dist.resize(n * n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const Weight *row = d.data() + i * stride;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                Weight v = row[j];
+                if constexpr (std::is_floating_point_v<Weight>)
+                {
+                    if (v == internalInfinity)
+                        v = AllPairsResult<Weight>::infinity;
+                }
+                else
+                {
+                    if (v > internalInfinity / 2)
+                        v = AllPairsResult<Weight>::infinity;
+                }
+                r.dist[i * n + j] = v;
+            }
+            if (row[i] < static_cast<Weight>(0))
+                r.negativeCycle = true;
+        }
+        trace.phaseEnd(TracePhase::Finalize);
+        return r;
+    }
+} // namespace Algorithms
@@ -0,0 +1,25 @@
+#pragma once
+#include "VertexIndex.hpp"
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+
+/**
+ * @brief A graph whose vertices are addressed by dense indices in [0, vertexCount()).
+ *
+ * Neighbours and weights of a vertex are exposed as contiguous spans, and
+ * vertexId()/indexOf() translate between dense indices and the external node IDs
+ * used by the API (indexOf returns -1 for unknown IDs). The shared VertexIndex
+ * lets results keyed by dense index reuse the graph's translation table.
+ */
+template <typename G>
+concept IndexedGraph = requires(const G& g, int u) {
+    typename G::weight_type;
+    { g.vertexCount() } -> std::convertible_to<std::size_t>;
+    { g.neighbors(u) } -> std::convertible_to<std::span<const int>>;
+    { g.weights(u) } -> std::convertible_to<std::span<const typename G::weight_type>>;
+    { g.vertexId(u) } -> std::convertible_to<int>;
+    { g.indexOf(u) } -> std::convertible_to<int>;
+    { g.sharedVertexIndex() } -> std::convertible_to<std::shared_ptr<const VertexIndex>>;
+};
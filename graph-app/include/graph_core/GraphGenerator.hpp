@@ -1,13 +1,27 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <random>
 #include <type_traits>
+#include <vector>
 #include "GraphStorage.hpp"
+#include "Parallel.hpp"
 
-template<typename T>
-T randomWeight(T minWeight, T maxWeight) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+/**
+ * @brief SplitMix64 mixer, used to derive independent per-chunk seeds from one user seed.
+ */
+inline std::uint64_t splitMix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
 
+template<typename T, typename Rng>
+T randomWeight(T minWeight, T maxWeight, Rng& gen) {
     if constexpr (std::is_integral_v<T>) {
         std::uniform_int_distribution<T> dist(minWeight, maxWeight);
         return dist(gen);
@@ -17,33 +31,122 @@ T randomWeight(T minWeight, T maxWeight) {
     }
 }
 
+// Unseeded convenience overload; each thread owns its engine.
+template<typename T>
+T randomWeight(T minWeight, T maxWeight) {
+    thread_local std::mt19937 gen(std::random_device{}());
+    return randomWeight(minWeight, maxWeight, gen);
+}
+
 class GraphGenerator {
 public:
+    template<typename T>
+    struct GeneratedEdge {
+        int from;
+        int to;
+        T weight;
+    };
+
+    /**
+     * @brief Edges of a G(n, p) Erdős–Rényi graph, in O(n + m) expected time.
+     *
+     * Candidate pairs are visited row by row (j != i for directed graphs, j > i
+     * otherwise) and the gap to the next edge is drawn from a geometric
+     * distribution instead of testing every pair. Rows are split into a fixed
+     * number of chunks that depend only on nodeCount; chunk c draws from its own
+     * engine seeded with splitMix64(seed ^ splitMix64(c)), so the result is the
+     * same for a given seed whatever the thread count.
+     */
+    template<typename T>
+    static std::vector<GeneratedEdge<T>> generateErdosRenyiEdges(
+        size_t nodeCount,
+        double edgeProbability,
+        T minWeight,
+        T maxWeight,
+        bool directed,
+        std::uint64_t seed,
+        unsigned threads = 0
+    ) {
+        if (nodeCount < 2 || edgeProbability <= 0.0) {
+            return {};
+        }
+
+        const size_t chunkCount = std::min<size_t>(nodeCount, maxChunks);
+        const size_t rowsPerChunk = (nodeCount + chunkCount - 1) / chunkCount;
+        const double logMiss = edgeProbability < 1.0 ? std::log1p(-edgeProbability) : 0.0;
+
+        std::vector<std::vector<GeneratedEdge<T>>> chunks(chunkCount);
+        std::atomic<size_t> cursor{0};
+        const double expectedEdges = edgeProbability * static_cast<double>(nodeCount) * static_cast<double>(nodeCount - 1);
+        threads = Parallel::threadsFor(static_cast<size_t>(expectedEdges), threads, 1 << 16);
+
+        Parallel::run(threads, [&](unsigned) {
+            for (size_t c = cursor.fetch_add(1); c < chunkCount; c = cursor.fetch_add(1)) {
+                std::mt19937_64 gen(splitMix64(seed ^ splitMix64(c)));
+                std::uniform_real_distribution<double> unit(0.0, 1.0);
+                auto& out = chunks[c];
+
+                // (i, k) is the next candidate pair: row i, k-th column of that row.
+                size_t i = c * rowsPerChunk, k = 0;
+                const size_t rowEnd = std::min(nodeCount, (c + 1) * rowsPerChunk);
+                while (i < rowEnd) {
+                    if (edgeProbability < 1.0) {
+                        // Geometric gap to the next edge, carried across rows of the chunk.
+                        double skip = std::floor(std::log1p(-unit(gen)) / logMiss);
+                        while (i < rowEnd && skip >= static_cast<double>(rowLength(i, nodeCount, directed) - k)) {
+                            skip -= static_cast<double>(rowLength(i, nodeCount, directed) - k);
+                            ++i;
+                            k = 0;
+                        }
+                        if (i >= rowEnd) {
+                            break;
+                        }
+                        k += static_cast<size_t>(skip);
+                    } else if (k >= rowLength(i, nodeCount, directed)) {
+                        ++i;
+                        k = 0;
+                        continue;
+                    }
+
+                    const size_t j = directed ? (k < i ? k : k + 1) : i + 1 + k;
+                    out.push_back({static_cast<int>(i), static_cast<int>(j), randomWeight(minWeight, maxWeight, gen)});
+                    ++k;
+                }
+            }
+        });
+
+        size_t total = 0;
+        for (const auto& chunk : chunks) {
+            total += chunk.size();
+        }
+        std::vector<GeneratedEdge<T>> edges;
+        edges.reserve(total);
+        for (auto& chunk : chunks) {
+            edges.insert(edges.end(), chunk.begin(), chunk.end());
+            std::vector<GeneratedEdge<T>>().swap(chunk);
+        }
+        return edges;
+    }
+
     template<typename T>
     static AdjacencyListGraph<T> generateAdjacencyListGraph(
         size_t nodeCount,
         double edgeProbability,
         T minWeight,
         T maxWeight,
-        bool directed
+        bool directed,
+        std::uint64_t seed = std::random_device{}(),
+        unsigned threads = 0
     ) {
         AdjacencyListGraph<T> graph(directed);
-
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> probDist(0.0, 1.0);
+        graph.reserve(nodeCount);
 
         for (size_t i = 0; i < nodeCount; ++i) {
             graph.addNode(i);
         }
 
-        for (size_t i = 0; i < nodeCount; ++i) {
-            for (size_t j = (directed ? 0 : i + 1); j < nodeCount; ++j) {
-                if (i != j && probDist(gen) < edgeProbability) {
-                    T weight = randomWeight(minWeight, maxWeight);
-                    graph.addEdge(i, j, weight);
-                }
-            }
+        for (const auto& e : generateErdosRenyiEdges(nodeCount, edgeProbability, minWeight, maxWeight, directed, seed, threads)) {
+            graph.addEdge(e.from, e.to, e.weight);
         }
 
         return graph;
@@ -55,23 +158,24 @@ public:
         double edgeProbability,
         T minWeight,
         T maxWeight,
-        bool directed
+        bool directed,
+        std::uint64_t seed = std::random_device{}(),
+        unsigned threads = 0
     ) {
         AdjacencyMatrixGraph<T> graph(nodeCount, directed);
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> probDist(0.0, 1.0);
-
-        for (size_t i = 0; i < nodeCount; ++i) {
-            for (size_t j = (directed ? 0 : i + 1); j < nodeCount; ++j) {
-                if (i != j && probDist(gen) < edgeProbability) {
-                    T weight = randomWeight(minWeight, maxWeight);
-                    graph.addEdge(i, j, weight);
-                }
-            }
+        for (const auto& e : generateErdosRenyiEdges(nodeCount, edgeProbability, minWeight, maxWeight, directed, seed, threads)) {
+            graph.addEdge(e.from, e.to, e.weight);
         }
 
         return graph;
     }
+
+private:
+    static constexpr size_t maxChunks = 4096;
+
+    // Candidate pairs in row i: every j != i, or only j > i when undirected.
+    static size_t rowLength(size_t i, size_t nodeCount, bool directed) {
+        return directed ? nodeCount - 1 : nodeCount - 1 - i;
+    }
 };
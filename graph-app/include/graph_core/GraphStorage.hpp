@@ -1,18 +1,40 @@
 #pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 #include <unordered_map>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 
+// Heap bytes owned by a string beyond the object itself (0 while it fits the small buffer).
+inline size_t stringHeapBytes(const std::string& s) {
+    return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+}
+
 /**
  * @brief Stores a graph as an adjacency list, with optional node labels.
  */
 template<typename Weight = double>
 class AdjacencyListGraph {
 public:
+    using weight_type = Weight;
+
     explicit AdjacencyListGraph(bool directed = false) : directed_(directed) {}
 
+    void reserve(size_t nodeCount) {
+        adj_list_.reserve(nodeCount);
+        node_labels_.reserve(nodeCount);
+    }
+
+    // Creates node id if needed and reserves room for count outgoing edges.
+    void reserveEdges(int id, size_t count) {
+        adj_list_[id].reserve(count);
+    }
+
     void addNode(int id, std::string_view label = "") {
         adj_list_[id]; // Ensure node exists
         node_labels_[id] = std::string(label);
@@ -24,6 +46,27 @@ public:
             adj_list_[to].emplace_back(from, weight.value_or(1));
     }
 
+    // Appends from -> to only, even when undirected; restores stored adjacency lists verbatim.
+    void addArc(int from, int to, Weight weight) {
+        adj_list_[from].emplace_back(to, weight);
+    }
+
+    // Removes every from -> to edge (and to -> from when undirected); returns how many arcs went.
+    size_t removeEdge(int from, int to) {
+        size_t removed = removeArcs(from, to);
+        if (!directed_ && from != to)
+            removed += removeArcs(to, from);
+        return removed;
+    }
+
+    // Sets the weight of every from -> to edge (and to -> from when undirected); false if there is none.
+    bool setEdgeWeight(int from, int to, Weight weight) {
+        bool found = setArcWeights(from, to, weight);
+        if (!directed_ && from != to)
+            setArcWeights(to, from, weight);
+        return found;
+    }
+
     const std::unordered_map<int, std::vector<std::pair<int, Weight>>>& getAdjList() const {
         return adj_list_;
     }
@@ -34,7 +77,39 @@ public:
 
     bool isDirected() const { return directed_; }
 
+    // Approximate heap footprint: hash buckets, one node per entry, edge vectors and labels.
+    size_t memoryBytes() const {
+        size_t bytes = sizeof(*this) + (adj_list_.bucket_count() + node_labels_.bucket_count()) * sizeof(void*);
+        for (const auto& [id, edges] : adj_list_)
+            bytes += sizeof(void*) + sizeof(std::pair<const int, std::vector<std::pair<int, Weight>>>)
+                   + edges.capacity() * sizeof(std::pair<int, Weight>);
+        for (const auto& [id, label] : node_labels_)
+            bytes += sizeof(void*) + sizeof(std::pair<const int, std::string>) + stringHeapBytes(label);
+        return bytes;
+    }
+
 private:
+    size_t removeArcs(int from, int to) {
+        auto it = adj_list_.find(from);
+        if (it == adj_list_.end())
+            return 0;
+        return std::erase_if(it->second, [to](const auto& arc) { return arc.first == to; });
+    }
+
+    bool setArcWeights(int from, int to, Weight weight) {
+        auto it = adj_list_.find(from);
+        if (it == adj_list_.end())
+            return false;
+        bool found = false;
+        for (auto& arc : it->second) {
+            if (arc.first == to) {
+                arc.second = weight;
+                found = true;
+            }
+        }
+        return found;
+    }
+
     bool directed_;
     std::unordered_map<int, std::vector<std::pair<int, Weight>>> adj_list_;
     std::unordered_map<int, std::string> node_labels_;
@@ -42,13 +117,60 @@ private:
 
 /**
  * @brief Stores a graph as an adjacency matrix, with optional node labels.
+ *
+ * Weights live in one contiguous row-major buffer of n * n entries; edge
+ * presence is a packed bitmap with rowWords() 64-bit words per row, so each
+ * row starts on a word boundary. Neighbor enumeration walks the presence words
+ * and jumps to set bits with countr_zero instead of testing every column.
  */
 template<typename Weight = double>
 class AdjacencyMatrixGraph {
 public:
+    using weight_type = Weight;
+
+    /**
+     * @brief Read-only row of the matrix; entry j is the weight of i -> j, if any.
+     */
+    class RowView {
+    public:
+        RowView(const Weight* weights, const std::uint64_t* presence, size_t n)
+            : weights_(weights), presence_(presence), size_(n) {}
+
+        std::optional<Weight> operator[](size_t j) const {
+            if ((presence_[j >> 6] >> (j & 63)) & 1)
+                return weights_[j];
+            return std::nullopt;
+        }
+
+        size_t size() const { return size_; }
+
+    private:
+        const Weight* weights_;
+        const std::uint64_t* presence_;
+        size_t size_;
+    };
+
+    /**
+     * @brief Read-only matrix view: view[i][j] is an optional weight, as the
+     * former vector-of-vectors storage exposed.
+     */
+    class MatrixView {
+    public:
+        explicit MatrixView(const AdjacencyMatrixGraph& graph) : graph_(&graph) {}
+
+        RowView operator[](size_t i) const {
+            return RowView(graph_->rowWeights(i).data(), graph_->rowPresence(i).data(), graph_->size_);
+        }
+
+        size_t size() const { return graph_->size_; }
+
+    private:
+        const AdjacencyMatrixGraph* graph_;
+    };
+
     explicit AdjacencyMatrixGraph(size_t n, bool directed = false)
-        : directed_(directed), size_(n),
-          matrix_(n, std::vector<std::optional<Weight>>(n, std::nullopt)),
+        : directed_(directed), size_(n), rowWords_((n + 63) / 64),
+          weights_(n * n, Weight{}), presence_(n * rowWords_, 0),
           node_labels_(n) {}
 
     void addNode(int id, std::string_view label = "") {
@@ -57,13 +179,64 @@ public:
     }
 
     void addEdge(int from, int to, std::optional<Weight> weight = std::nullopt) {
-        matrix_[from][to] = weight.value_or(1);
+        set(from, to, weight.value_or(1));
         if (!directed_ && from != to)
-            matrix_[to][from] = weight.value_or(1);
+            set(to, from, weight.value_or(1));
     }
 
-    const std::vector<std::vector<std::optional<Weight>>>& getMatrix() const {
-        return matrix_;
+    bool hasEdge(size_t from, size_t to) const {
+        return (presence_[from * rowWords_ + (to >> 6)] >> (to & 63)) & 1;
+    }
+
+    std::optional<Weight> edgeWeight(size_t from, size_t to) const {
+        if (hasEdge(from, to))
+            return weights_[from * size_ + to];
+        return std::nullopt;
+    }
+
+    MatrixView getMatrix() const {
+        return MatrixView(*this);
+    }
+
+    // Raw row i: weights of absent edges are Weight{}; check rowPresence first.
+    std::span<const Weight> rowWeights(size_t i) const {
+        return {weights_.data() + i * size_, size_};
+    }
+
+    std::span<const std::uint64_t> rowPresence(size_t i) const {
+        return {presence_.data() + i * rowWords_, rowWords_};
+    }
+
+    size_t rowWords() const { return rowWords_; }
+
+    size_t degree(size_t i) const {
+        size_t d = 0;
+        for (std::uint64_t w : rowPresence(i))
+            d += static_cast<size_t>(std::popcount(w));
+        return d;
+    }
+
+    // Calls f(j, weight) for every edge i -> j, in increasing j.
+    template<typename F>
+    void forEachNeighbor(size_t i, F&& f) const {
+        const auto presence = rowPresence(i);
+        const Weight* row = weights_.data() + i * size_;
+        for (size_t w = 0; w < presence.size(); ++w) {
+            std::uint64_t bits = presence[w];
+            while (bits) {
+                const size_t j = (w << 6) + static_cast<size_t>(std::countr_zero(bits));
+                f(j, row[j]);
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // Directed edges stored (each undirected edge counts twice, self-loops once).
+    size_t edgeCount() const {
+        size_t m = 0;
+        for (std::uint64_t w : presence_)
+            m += static_cast<size_t>(std::popcount(w));
+        return m;
     }
 
     const std::vector<std::string>& getNodeLabels() const {
@@ -73,9 +246,69 @@ public:
     bool isDirected() const { return directed_; }
     size_t size() const { return size_; }
 
+    size_t memoryBytes() const {
+        size_t bytes = sizeof(*this) + weights_.capacity() * sizeof(Weight)
+                     + presence_.capacity() * sizeof(std::uint64_t)
+                     + node_labels_.capacity() * sizeof(std::string);
+        for (const auto& label : node_labels_)
+            bytes += stringHeapBytes(label);
+        return bytes;
+    }
+
 private:
+    void set(size_t from, size_t to, Weight weight) {
+        weights_[from * size_ + to] = weight;
+        presence_[from * rowWords_ + (to >> 6)] |= std::uint64_t{1} << (to & 63);
+    }
+
     bool directed_;
     size_t size_;
-    std::vector<std::vector<std::optional<Weight>>> matrix_;
+    size_t rowWords_;
+    std::vector<Weight> weights_;
+    std::vector<std::uint64_t> presence_;
     std::vector<std::string> node_labels_;
-};
\ No newline at end of file
+};
+
+/**
+ * @brief One edit of a batch of edge changes (see applyEdgeChanges).
+ */
+template<typename Weight = double>
+struct EdgeChange {
+    enum class Kind { Insert, Remove, SetWeight };
+
+    Kind kind = Kind::Insert;
+    int from = 0;
+    int to = 0;
+    Weight weight = Weight{1}; // ignored by Remove
+};
+
+/**
+ * @brief Applies a batch of edge changes in order.
+ *
+ * Insert adds an edge like addEdge() and creates both endpoints as nodes;
+ * Remove and SetWeight act on every from -> to edge, as removeEdge() and
+ * setEdgeWeight() do. Removing or reweighting an edge that does not exist
+ * throws std::invalid_argument with the graph partly changed, so apply
+ * batches to a copy when they must be all-or-nothing.
+ */
+template<typename Weight>
+void applyEdgeChanges(AdjacencyListGraph<Weight>& graph, std::span<const EdgeChange<Weight>> changes) {
+    for (const auto& change : changes) {
+        switch (change.kind) {
+            case EdgeChange<Weight>::Kind::Insert:
+                graph.reserveEdges(change.to, 0); // a directed edge's target becomes a node too
+                graph.addEdge(change.from, change.to, change.weight);
+                break;
+            case EdgeChange<Weight>::Kind::Remove:
+                if (graph.removeEdge(change.from, change.to) == 0)
+                    throw std::invalid_argument("No edge " + std::to_string(change.from) + " -> "
+                                                + std::to_string(change.to));
+                break;
+            case EdgeChange<Weight>::Kind::SetWeight:
+                if (!graph.setEdgeWeight(change.from, change.to, change.weight))
+                    throw std::invalid_argument("No edge " + std::to_string(change.from) + " -> "
+                                                + std::to_string(change.to));
+                break;
+        }
+    }
+}
@@ -0,0 +1,291 @@
+#pragma once
+#include "CsrGraph.hpp"
+#include "GraphConcepts.hpp"
+#include "Parallel.hpp"
+#include "Trace.hpp"
+#include "VertexIndex.hpp"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ---------- Resultado de la BFS multi-origen ----------
+
+struct MultiSourceBFSResult
+{
+    std::vector<int> sources;               // IDs de origen, en el orden pedido
+    std::vector<std::size_t> reached;       // vértices alcanzados desde cada origen (él incluido; 0 si no existe)
+    std::vector<int> eccentricity;          // mayor profundidad alcanzada (-1 si el origen no existe)
+    std::vector<std::uint64_t> distanceSum; // suma de las profundidades de los vértices alcanzados
+    std::vector<VertexMap<int>> depth;      // profundidad por origen (max si no se alcanza); vacío sin depths
+    std::size_t vertexCount = 0;
+
+    // Cercanía de Wasserman–Faust, válida también en grafos no conexos:
+    // (r - 1) / (n - 1) * (r - 1) / suma, con r los vértices alcanzados. 0 si r <= 1.
+    double closeness(std::size_t i) const
+    {
+        if (reached[i] <= 1 || vertexCount <= 1)
+            return 0.0;
+        const double r = static_cast<double>(reached[i] - 1);
+        return r / static_cast<double>(vertexCount - 1) * r / static_cast<double>(distanceSum[i]);
+    }
+};
+
+namespace Algorithms
+{
+    // ---------- BFS multi-origen con paralelismo de bits (MS-BFS) ----------
+    //
+    // Recorre el grafo desde muchos orígenes a la vez (Then et al., "The More
+    // the Merrier"). Los orígenes se agrupan en lotes de 64: cada vértice guarda
+    // una palabra `seen` con un bit por origen del lote que ya lo alcanzó, y las
+    // palabras `frontier`/`next` marcan qué orígenes lo tienen en la frontera.
+    // Expandir un nivel es un OR de palabras por arista, de modo que un solo
+    // recorrido de la lista de aristas sirve a los 64 orígenes.
+    //
+    // Cada nivel tiene dos fases separadas por barreras:
+    //   - expansión: top-down (next[v] |= frontier[u] por cada arista u -> v, con
+    //     fetch_or atómico) o bottom-up (cada v hace OR de frontier[u] de sus
+    //     aristas de entrada y para en cuanto cubre los orígenes que le faltan),
+    //     según el criterio de ParallelBFS: bottom-up si las aristas de la
+    //     frontera superan m / alpha, y vuelta a top-down si sus vértices son
+    //     menos de n / beta;
+    //   - asentamiento: por cada v, los bits nuevos son next[v] & ~seen[v]; pasan
+    //     a ser la frontera, se añaden a seen y se anotan profundidad y agregados.
+    // Las fases recorren el grafo en bloques repartidos dinámicamente entre hilos.
+
+    struct MultiSourceBFSOptions
+    {
+        unsigned threads = 0; // 0 = hardware_concurrency
+        bool depths = true;   // false: solo agregados (alcanzados, excentricidad, cercanía)
+        std::size_t alpha = 14;
+        std::size_t beta = 24;
+    };
+
+    // `incoming` debe tener los mismos vértices que `out` con las aristas invertidas
+    // (para grafos no dirigidos, el propio grafo).
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    MultiSourceBFSResult MultiSourceBFS(const G &out, const G &incoming, std::span<const int> sources,
+                                        MultiSourceBFSOptions options = {}, Trace &&trace = {})
+    {
+        constexpr int unvisited = std::numeric_limits<int>::max();
+        constexpr std::size_t chunkVertices = 4096;
+        using Word = std::uint64_t;
+
+        MultiSourceBFSResult result;
+        trace.phaseBegin(TracePhase::Init);
+        const std::size_t n = out.vertexCount();
+        const std::size_t k = sources.size();
+        result.sources.assign(sources.begin(), sources.end());
+        result.reached.assign(k, 0);
+        result.eccentricity.assign(k, -1);
+        result.distanceSum.assign(k, 0);
+        result.vertexCount = n;
+        if (options.depths)
+            result.depth.assign(k, VertexMap<int>(out.sharedVertexIndex(), unvisited));
+        if (k == 0 || n == 0)
+        {
+            trace.phaseEnd(TracePhase::Init);
+            return result;
+        }
+
+        std::size_t edges = 0;
+        for (std::size_t u = 0; u < n; ++u)
+            edges += out.neighbors(static_cast<int>(u)).size();
+
+        const unsigned threads = Parallel::threadsFor(n, options.threads, chunkVertices);
+        const std::size_t chunks = (n + chunkVertices - 1) / chunkVertices;
+        std::vector<Word> seen(n), frontier(n), next(n);
+
+        // contadores de cada hilo en la fase de asentamiento
+        struct alignas(64) LevelStats
+        {
+            std::size_t newBits[64] = {}; // vértices nuevos por origen del lote
+            std::size_t vertices = 0;     // vértices con algún bit nuevo (tamaño de la frontera)
+            std::size_t edges = 0;        // sus aristas de salida
+            std::size_t scanned = 0;      // aristas examinadas (solo con Trace::enabled)
+        };
+        std::vector<LevelStats> stats(threads);
+
+        std::size_t batch = 0, width = 0; // lote actual: orígenes [batch, batch + width)
+        Word batchMask = 0;
+        int level = 0;
+        bool bottomUp = false, done = false;
+        std::size_t settled = 0, scanned = 0;
+        std::atomic<std::size_t> cursor{0};
+
+        // Prepara el lote que empieza en `batch`: nivel 0 con cada origen en su vértice.
+        auto startBatch = [&]()
+        {
+            std::fill(seen.begin(), seen.end(), Word{0});
+            std::fill(frontier.begin(), frontier.end(), Word{0});
+            width = std::min<std::size_t>(64, k - batch);
+            batchMask = width == 64 ? ~Word{0} : (Word{1} << width) - 1;
+            level = 0;
+            bottomUp = false;
+            for (std::size_t b = 0; b < width; ++b)
+            {
+                const int s = out.indexOf(sources[batch + b]);
+                if (s < 0)
+                    continue;
+                seen[s] |= Word{1} << b;
+                frontier[s] |= Word{1} << b;
+                result.reached[batch + b] = 1;
+                result.eccentricity[batch + b] = 0;
+                if (options.depths)
+                    result.depth[batch + b].dense()[s] = 0;
+                ++settled;
+            }
+        };
+
+        auto onExpandEnd = [&]() noexcept { cursor.store(0, std::memory_order_relaxed); };
+
+        auto onLevelEnd = [&]() noexcept
+        {
+            std::size_t nf = 0, mf = 0;
+            std::size_t newBits[64] = {};
+            for (auto &st : stats)
+            {
+                for (std::size_t b = 0; b < width; ++b)
+                    newBits[b] += st.newBits[b];
+                nf += st.vertices;
+                mf += st.edges;
+                scanned += st.scanned;
+                st = {};
+            }
+            cursor.store(0, std::memory_order_relaxed);
+            ++level;
+
+            for (std::size_t b = 0; b < width; ++b)
+            {
+                if (newBits[b] == 0)
+                    continue;
+                result.reached[batch + b] += newBits[b];
+                result.distanceSum[batch + b] += newBits[b] * static_cast<std::uint64_t>(level);
+                result.eccentricity[batch + b] = level;
+                settled += newBits[b];
+            }
+
+            if (nf == 0)
+            {
+                batch += width;
+                if (batch >= k)
+                    done = true;
+                else
+                    startBatch();
+                return;
+            }
+            if (!bottomUp && mf > edges / options.alpha)
+                bottomUp = true;
+            else if (bottomUp && nf < n / options.beta)
+                bottomUp = false;
+        };
+
+        std::barrier expandSync(static_cast<std::ptrdiff_t>(threads), onExpandEnd);
+        std::barrier levelSync(static_cast<std::ptrdiff_t>(threads), onLevelEnd);
+        startBatch();
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        Parallel::run(threads, [&](unsigned tid)
+        {
+            while (!done)
+            {
+                LevelStats &st = stats[tid];
+
+                // expansión: next acumula, por vértice, los orígenes que llegan desde la frontera
+                for (std::size_t c = cursor.fetch_add(1, std::memory_order_relaxed); c < chunks;
+                     c = cursor.fetch_add(1, std::memory_order_relaxed))
+                {
+                    const std::size_t begin = c * chunkVertices, end = std::min(n, begin + chunkVertices);
+                    if (bottomUp)
+                    {
+                        // cada hilo es dueño de next[v] de su bloque: escritura sin atómicos
+                        for (std::size_t v = begin; v < end; ++v)
+                        {
+                            const Word missing = batchMask & ~seen[v];
+                            if (!missing)
+                                continue;
+                            Word reach = 0;
+                            for (int u : incoming.neighbors(static_cast<int>(v)))
+                            {
+                                if constexpr (std::remove_cvref_t<Trace>::enabled)
+                                    ++st.scanned;
+                                reach |= frontier[u];
+                                if ((reach & missing) == missing)
+                                    break;
+                            }
+                            next[v] = reach & missing;
+                        }
+                    }
+                    else
+                    {
+                        for (std::size_t u = begin; u < end; ++u)
+                        {
+                            const Word bits = frontier[u];
+                            if (!bits)
+                                continue;
+                            if constexpr (std::remove_cvref_t<Trace>::enabled)
+                                st.scanned += out.neighbors(static_cast<int>(u)).size();
+                            for (int v : out.neighbors(static_cast<int>(u)))
+                            {
+                                // solo escribe si aporta bits que v aún no tiene
+                                std::atomic_ref<Word> nv(next[v]);
+                                if ((bits & ~seen[v] & ~nv.load(std::memory_order_relaxed)) != 0)
+                                    nv.fetch_or(bits, std::memory_order_relaxed);
+                            }
+                        }
+                    }
+                }
+                expandSync.arrive_and_wait();
+
+                // asentamiento: los bits nuevos de cada vértice forman la siguiente frontera
+                const int depthNow = level + 1;
+                for (std::size_t c = cursor.fetch_add(1, std::memory_order_relaxed); c < chunks;
+                     c = cursor.fetch_add(1, std::memory_order_relaxed))
+                {
+                    const std::size_t begin = c * chunkVertices, end = std::min(n, begin + chunkVertices);
+                    for (std::size_t v = begin; v < end; ++v)
+                    {
+                        const Word fresh = next[v] & ~seen[v];
+                        next[v] = 0;
+                        frontier[v] = fresh;
+                        if (!fresh)
+                            continue;
+                        seen[v] |= fresh;
+                        ++st.vertices;
+                        st.edges += out.neighbors(static_cast<int>(v)).size();
+                        for (Word bits = fresh; bits; bits &= bits - 1)
+                        {
+                            const int b = std::countr_zero(bits);
+                            ++st.newBits[b];
+                            if (options.depths)
+                                result.depth[batch + b].dense()[v] = depthNow;
+                        }
+                    }
+                }
+                levelSync.arrive_and_wait();
+            }
+        });
+        trace.vertexSettled(settled);
+        trace.edgeRelaxed(scanned);
+        trace.phaseEnd(TracePhase::Search);
+
+        return result;
+    }
+
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    MultiSourceBFSResult MultiSourceBFS(const CsrGraph<Weight> &g, std::span<const int> sources,
+                                        MultiSourceBFSOptions options = {}, Trace &&trace = {})
+    {
+        if (!g.isDirected())
+            return MultiSourceBFS(g, g, sources, options, std::forward<Trace>(trace));
+        return MultiSourceBFS(g, g.transposed(), sources, options, std::forward<Trace>(trace));
+    }
+} // namespace Algorithms
@@ -0,0 +1,139 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Minimal fork-join helpers shared by the parallel algorithms.
+ */
+namespace Parallel
+{
+    inline unsigned defaultThreads()
+    {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    // Resolves a requested thread count. An explicit request is honoured up to hardware
+    // concurrency; 0 means hardware concurrency, capped so each thread gets at least
+    // minWorkPerThread items.
+    inline unsigned threadsFor(std::size_t work, unsigned requested, std::size_t minWorkPerThread = 1024)
+    {
+        if (requested)
+            return std::min(requested, defaultThreads());
+        std::size_t useful = std::max<std::size_t>(1, work / std::max<std::size_t>(1, minWorkPerThread));
+        return static_cast<unsigned>(std::min<std::size_t>(defaultThreads(), useful));
+    }
+
+    // First exception thrown by any of a group of threads, kept to be rethrown on the
+    // calling thread once they have all stopped. failed() is a cheap flag to poll.
+    class FirstError
+    {
+    public:
+        void capture() noexcept
+        {
+            std::lock_guard lock(mutex_);
+            if (!error_)
+                error_ = std::current_exception();
+            failed_.store(true, std::memory_order_relaxed);
+        }
+
+        bool failed() const noexcept { return failed_.load(std::memory_order_relaxed); }
+
+        // Only once the threads that may capture() have been joined.
+        void rethrow() const
+        {
+            if (error_)
+                std::rethrow_exception(error_);
+        }
+
+    private:
+        std::mutex mutex_;
+        std::exception_ptr error_;
+        std::atomic<bool> failed_{false};
+    };
+
+    // Runs body(tid) for tid in [0, threads), tid 0 on the calling thread, and joins.
+    //
+    // No body starts until every worker exists, so if creating a worker throws, the ones
+    // already started return without running body. An exception thrown by a body is caught
+    // on its own thread, and the first one is rethrown here once every thread has joined.
+    //
+    // Bodies that meet at a std::barrier must not let an exception escape: the other
+    // threads would wait at the barrier forever. Such bodies catch it themselves, record it
+    // in a FirstError, and leave their loop together after the next barrier.
+    template <typename F>
+    void run(unsigned threads, F &&body)
+    {
+        enum : int { Waiting, Go, Abort };
+        std::atomic<int> start{Waiting};
+        FirstError error;
+        std::vector<std::jthread> workers;
+        try
+        {
+            workers.reserve(threads > 0 ? threads - 1 : 0);
+            for (unsigned t = 1; t < threads; ++t)
+            {
+                workers.emplace_back([&body, &start, &error, t]
+                {
+                    start.wait(Waiting, std::memory_order_acquire);
+                    if (start.load(std::memory_order_acquire) != Go)
+                        return;
+                    try
+                    {
+                        body(t);
+                    }
+                    catch (...)
+                    {
+                        error.capture();
+                    }
+                });
+            }
+        }
+        catch (...)
+        {
+            start.store(Abort, std::memory_order_release);
+            start.notify_all();
+            throw;
+        }
+        start.store(Go, std::memory_order_release);
+        start.notify_all();
+        try
+        {
+            body(0u);
+        }
+        catch (...)
+        {
+            error.capture();
+        }
+        workers.clear(); // joins
+        error.rethrow();
+    }
+
+    // Runs body(begin, end, tid) over [0, n) in chunks of `chunk` items that the
+    // threads take dynamically, so uneven work per item still balances.
+    template <typename F>
+    void forChunks(std::size_t n, unsigned threads, std::size_t chunk, F &&body)
+    {
+        std::atomic<std::size_t> cursor{0};
+        run(threads, [&](unsigned tid)
+        {
+            for (std::size_t begin = cursor.fetch_add(chunk, std::memory_order_relaxed); begin < n;
+                 begin = cursor.fetch_add(chunk, std::memory_order_relaxed))
+                body(begin, std::min(n, begin + chunk), tid);
+        });
+    }
+
+    // Static block partition of [0, n) for thread tid.
+    inline std::pair<std::size_t, std::size_t> block(std::size_t n, unsigned tid, unsigned threads)
+    {
+        std::size_t per = n / threads, extra = n % threads;
+        std::size_t begin = tid * per + std::min<std::size_t>(tid, extra);
+        return {begin, begin + per + (tid < extra ? 1 : 0)};
+    }
+} // namespace Parallel
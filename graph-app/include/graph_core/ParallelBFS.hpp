@@ -0,0 +1,219 @@
+#pragma once
+#include "algorithms.hpp"
+#include "Bitmap.hpp"
+#include "CsrGraph.hpp"
+#include "GraphConcepts.hpp"
+#include "Parallel.hpp"
+#include "Trace.hpp"
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Algorithms
+{
+    // ---------- BFS paralela con optimización de dirección ----------
+    //
+    // BFS por niveles (Beamer et al.) con fronteras en bitmaps. Cada nivel se
+    // expande top-down (la frontera recorre sus aristas de salida) o bottom-up
+    // (cada vértice no visitado busca un padre en la frontera entre sus aristas
+    // de entrada), según el tamaño de la frontera:
+    //   - top-down -> bottom-up cuando m_f > m_u / alpha
+    //   - bottom-up -> top-down cuando n_f < n / beta
+    // donde m_f son las aristas de la frontera, m_u las aristas aún sin explorar
+    // y n_f los vértices de la frontera.
+    //
+    // Devuelve la misma semántica que BFS: depth es la distancia en saltos y
+    // parent un padre en el nivel anterior (ante empates puede diferir del de
+    // la BFS secuencial). order lista los vértices por nivel y, dentro de cada
+    // nivel, por índice denso.
+
+    struct ParallelBFSOptions
+    {
+        unsigned threads = 0; // 0 = hardware_concurrency
+        std::size_t alpha = 14;
+        std::size_t beta = 24;
+    };
+
+    // `incoming` debe tener los mismos vértices que `out` con las aristas invertidas
+    // (para grafos no dirigidos, el propio grafo).
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    TraversalResult ParallelBFS(const G &out, const G &incoming, int source, ParallelBFSOptions options = {},
+                                Trace &&trace = {})
+    {
+        constexpr int unvisited = std::numeric_limits<int>::max();
+        constexpr std::size_t chunkWords = 64; // 4096 vértices por bloque de trabajo
+
+        TraversalResult result;
+        result.source = source;
+
+        trace.phaseBegin(TracePhase::Init);
+        const std::size_t n = out.vertexCount();
+        result.parent = VertexMap<int>(out.sharedVertexIndex(), -1);
+        result.depth = VertexMap<int>(out.sharedVertexIndex(), unvisited);
+        auto &parent = result.parent.dense();
+        auto &depth = result.depth.dense();
+
+        const int s = out.indexOf(source);
+        if (s < 0)
+        {
+            trace.phaseEnd(TracePhase::Init);
+            return result;
+        }
+
+        const unsigned threads = Parallel::threadsFor(n, options.threads, 4096);
+
+        Bitmap frontier(n), next(n);
+        frontier.set(s);
+        depth[s] = 0;
+
+        std::size_t unexploredEdges = 0;
+        for (std::size_t u = 0; u < n; ++u)
+            unexploredEdges += out.neighbors(static_cast<int>(u)).size();
+
+        struct alignas(64) LevelStats
+        {
+            std::size_t vertices = 0;
+            std::size_t edges = 0;
+            std::size_t scanned = 0; // aristas examinadas (solo con Trace::enabled)
+        };
+        std::vector<LevelStats> stats(threads);
+
+        std::size_t settled = 1, scanned = 0;
+        int level = 0;
+        bool bottomUp = false;
+        bool done = false;
+        unexploredEdges -= out.neighbors(s).size();
+        std::atomic<std::size_t> cursor{0};
+        const std::size_t chunks = (frontier.wordCount() + chunkWords - 1) / chunkWords;
+
+        auto onLevelEnd = [&]() noexcept
+        {
+            std::size_t nf = 0, mf = 0;
+            for (auto &st : stats)
+            {
+                nf += st.vertices;
+                mf += st.edges;
+                scanned += st.scanned;
+                st = {};
+            }
+            settled += nf;
+            frontier.swap(next);
+            next.clear();
+            cursor.store(0, std::memory_order_relaxed);
+            ++level;
+
+            if (nf == 0)
+            {
+                done = true;
+                return;
+            }
+            unexploredEdges -= std::min(unexploredEdges, mf);
+            if (!bottomUp && mf > unexploredEdges / options.alpha)
+                bottomUp = true;
+            else if (bottomUp && nf < n / options.beta)
+                bottomUp = false;
+        };
+        std::barrier sync(static_cast<std::ptrdiff_t>(threads), onLevelEnd);
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        Parallel::run(threads, [&](unsigned tid)
+        {
+            while (!done)
+            {
+                LevelStats &st = stats[tid];
+                const int nextDepth = level + 1;
+                for (std::size_t c = cursor.fetch_add(1, std::memory_order_relaxed); c < chunks;
+                     c = cursor.fetch_add(1, std::memory_order_relaxed))
+                {
+                    const std::size_t wordBegin = c * chunkWords;
+                    const std::size_t wordEnd = std::min(frontier.wordCount(), wordBegin + chunkWords);
+                    if (bottomUp)
+                    {
+                        // cada hilo es dueño de sus palabras de `next`: escritura sin atómicos
+                        const std::size_t vEnd = std::min(n, wordEnd * 64);
+                        for (std::size_t v = wordBegin * 64; v < vEnd; ++v)
+                        {
+                            if (depth[v] != unvisited)
+                                continue;
+                            for (int u : incoming.neighbors(static_cast<int>(v)))
+                            {
+                                if constexpr (std::remove_cvref_t<Trace>::enabled)
+                                    ++st.scanned;
+                                if (frontier.test(u))
+                                {
+                                    depth[v] = nextDepth;
+                                    parent[v] = out.vertexId(u);
+                                    next.set(v);
+                                    ++st.vertices;
+                                    st.edges += out.neighbors(static_cast<int>(v)).size();
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                    else
+                    {
+                        frontier.forEachSetBit(wordBegin, wordEnd, [&](std::size_t u)
+                        {
+                            if constexpr (std::remove_cvref_t<Trace>::enabled)
+                                st.scanned += out.neighbors(static_cast<int>(u)).size();
+                            for (int v : out.neighbors(static_cast<int>(u)))
+                            {
+                                std::atomic_ref<int> dv(depth[v]);
+                                int expected = unvisited;
+                                if (dv.load(std::memory_order_relaxed) == unvisited &&
+                                    dv.compare_exchange_strong(expected, nextDepth, std::memory_order_relaxed))
+                                {
+                                    parent[v] = out.vertexId(static_cast<int>(u));
+                                    next.setAtomic(v);
+                                    ++st.vertices;
+                                    st.edges += out.neighbors(v).size();
+                                }
+                            }
+                        });
+                    }
+                }
+                sync.arrive_and_wait();
+            }
+        });
+        trace.vertexSettled(settled);
+        trace.edgeRelaxed(scanned);
+        trace.phaseEnd(TracePhase::Search);
+
+        // orden por niveles (counting sort por profundidad)
+        trace.phaseBegin(TracePhase::Finalize);
+        std::vector<std::size_t> levelStart(level + 2, 0);
+        for (std::size_t v = 0; v < n; ++v)
+            if (depth[v] != unvisited)
+                ++levelStart[depth[v] + 1];
+        for (std::size_t d = 1; d < levelStart.size(); ++d)
+            levelStart[d] += levelStart[d - 1];
+        result.order.resize(levelStart.back());
+        for (std::size_t v = 0; v < n; ++v)
+            if (depth[v] != unvisited)
+                result.order[levelStart[depth[v]]++] = out.vertexId(static_cast<int>(v));
+        trace.phaseEnd(TracePhase::Finalize);
+
+        return result;
+    }
+
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    TraversalResult ParallelBFS(const CsrGraph<Weight> &g, int source, ParallelBFSOptions options = {},
+                                Trace &&trace = {})
+    {
+        if (!g.isDirected())
+            return ParallelBFS(g, g, source, options, std::forward<Trace>(trace));
+        return ParallelBFS(g, g.transposed(), source, options, std::forward<Trace>(trace));
+    }
+
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    TraversalResult ParallelBFS(const AdjacencyListGraph<Weight> &g, int source, ParallelBFSOptions options = {},
+                                Trace &&trace = {})
+    {
+        return ParallelBFS(CsrGraph<Weight>(g), source, options, std::forward<Trace>(trace));
+    }
+} // namespace Algorithms
@@ -0,0 +1,154 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Monotone min-priority queue for non-negative integer keys (radix heap).
+ *
+ * Entries live in bucketCount buckets: bucket 0 holds keys equal to the last
+ * popped key, and bucket b > 0 keys whose highest bit differing from it is
+ * b - 1. pop() empties bucket 0 first; when it is empty, the first non-empty
+ * bucket is redistributed around its minimum, and every entry moves to a
+ * strictly lower bucket. Each entry moves at most once per bit of Key, so a
+ * push/pop pair costs O(log C) amortized, C the largest key - last popped key,
+ * with no comparisons between entries: just vector appends and a bit_width.
+ *
+ * Keys pushed must be non-negative and not smaller than the last popped key,
+ * which holds for Dijkstra with non-negative weights. Equal keys pop in no
+ * particular order.
+ */
+template <std::integral Key>
+class RadixHeap {
+public:
+    struct Entry {
+        Key key;
+        int value;
+    };
+
+    bool empty() const { return size_ == 0; }
+    std::size_t size() const { return size_; }
+
+    void push(Key key, int value) {
+        buckets_[bucketOf(static_cast<Unsigned>(key))].push_back({key, value});
+        ++size_;
+    }
+
+    Entry pop() {
+        if (buckets_[0].empty()) {
+            std::size_t b = 1;
+            while (buckets_[b].empty())
+                ++b;
+            auto& bucket = buckets_[b];
+            last_ = static_cast<Unsigned>(bucket.front().key);
+            for (const Entry& e : bucket)
+                last_ = std::min(last_, static_cast<Unsigned>(e.key));
+            for (const Entry& e : bucket)
+                buckets_[bucketOf(static_cast<Unsigned>(e.key))].push_back(e);
+            bucket.clear();
+        }
+        Entry e = buckets_[0].back();
+        buckets_[0].pop_back();
+        --size_;
+        return e;
+    }
+
+private:
+    using Unsigned = std::make_unsigned_t<Key>;
+    static constexpr std::size_t bucketCount = std::numeric_limits<Unsigned>::digits + 1;
+
+    std::size_t bucketOf(Unsigned key) const {
+        return static_cast<std::size_t>(std::bit_width(static_cast<Unsigned>(key ^ last_)));
+    }
+
+    std::array<std::vector<Entry>, bucketCount> buckets_;
+    Unsigned last_ = 0;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Min-priority queue as an implicit heap with Arity children per node.
+ *
+ * With 4 children the heap is half as deep as a binary one and the children of
+ * a node share a cache line, which pays off on pop(), the expensive side in
+ * Dijkstra. Works for any key ordered by operator<.
+ */
+template <typename Key, std::size_t Arity = 4>
+class DaryHeap {
+public:
+    struct Entry {
+        Key key;
+        int value;
+    };
+
+    bool empty() const { return heap_.empty(); }
+    std::size_t size() const { return heap_.size(); }
+
+    void push(Key key, int value) {
+        std::size_t i = heap_.size();
+        heap_.push_back({key, value});
+        const Entry e = heap_[i];
+        while (i > 0) {
+            const std::size_t parent = (i - 1) / Arity;
+            if (!(e.key < heap_[parent].key))
+                break;
+            heap_[i] = heap_[parent];
+            i = parent;
+        }
+        heap_[i] = e;
+    }
+
+    Entry pop() {
+        const Entry top = heap_.front();
+        const Entry e = heap_.back();
+        heap_.pop_back();
+        const std::size_t n = heap_.size();
+        if (n > 0) {
+            std::size_t i = 0;
+            while (true) {
+                const std::size_t first = i * Arity + 1;
+                if (first >= n)
+                    break;
+                std::size_t best = first;
+                const std::size_t last = std::min(first + Arity, n);
+                for (std::size_t c = first + 1; c < last; ++c) {
+                    if (heap_[c].key < heap_[best].key)
+                        best = c;
+                }
+                if (!(heap_[best].key < e.key))
+                    break;
+                heap_[i] = heap_[best];
+                i = best;
+            }
+            heap_[i] = e;
+        }
+        return top;
+    }
+
+private:
+    std::vector<Entry> heap_;
+};
+
+/**
+ * @brief Priority queue for label-setting shortest path searches, chosen from
+ * the key type at compile time: RadixHeap for integer distances, DaryHeap
+ * otherwise. Both take push(key, vertex) and return {key, value} from pop().
+ */
+template <typename Key>
+struct MonotoneQueueFor {
+    using type = DaryHeap<Key>;
+};
+
+template <std::integral Key>
+struct MonotoneQueueFor<Key> {
+    using type = RadixHeap<Key>;
+};
+
+template <typename Key>
+using MonotoneQueue = typename MonotoneQueueFor<Key>::type;
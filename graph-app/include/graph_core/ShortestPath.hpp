@@ -0,0 +1,238 @@
+#pragma once
+#include "algorithms.hpp"
+#include "CsrGraph.hpp"
+#include "GraphConcepts.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ---------- Resultado de una consulta origen-destino ----------
+
+template <typename Weight>
+struct PathResult
+{
+    int source = -1;
+    int target = -1;
+    bool found = false;
+    Weight cost{};         // longitud del camino (si found)
+    std::vector<int> path; // IDs desde source hasta target (vacío si no hay camino)
+};
+
+/**
+ * @brief Planar node coordinates used to build A* heuristics.
+ *
+ * Stored per dense vertex index of the graph the query runs on.
+ */
+struct NodeCoordinates
+{
+    std::vector<double> x;
+    std::vector<double> y;
+};
+
+/**
+ * @brief Straight-line lower bound: scale * ||p(u) - p(v)||.
+ *
+ * Admissible and consistent as long as every edge weight is at least
+ * scale times the distance between its endpoints.
+ */
+struct EuclideanHeuristic
+{
+    const NodeCoordinates *coords;
+    double scale = 1.0;
+    double operator()(int u, int v) const
+    {
+        return scale * std::hypot(coords->x[u] - coords->x[v], coords->y[u] - coords->y[v]);
+    }
+};
+
+/**
+ * @brief Manhattan lower bound: scale * (|dx| + |dy|), for grid-like graphs.
+ */
+struct ManhattanHeuristic
+{
+    const NodeCoordinates *coords;
+    double scale = 1.0;
+    double operator()(int u, int v) const
+    {
+        return scale * (std::abs(coords->x[u] - coords->x[v]) + std::abs(coords->y[u] - coords->y[v]));
+    }
+};
+
+/**
+ * @brief No heuristic: A* degenerates into plain bidirectional Dijkstra.
+ */
+struct NoHeuristic
+{
+};
+
+namespace Algorithms
+{
+    // ---------- Dijkstra bidireccional / A* bidireccional ----------
+    //
+    // Una búsqueda avanza desde source sobre `out` y otra desde target sobre
+    // `incoming` (las aristas invertidas), expandiendo siempre la de menor clave.
+    // mu guarda el mejor camino encontrado al unir ambas; la búsqueda termina en
+    // cuanto la suma de las dos claves mínimas alcanza mu, sin recorrer el resto
+    // del grafo.
+    //
+    // Con una heurística h(u, v) (cota inferior consistente de la distancia) se
+    // usan los potenciales promedio pf(v) = (h(v, t) - h(s, v)) / 2 para la ida y
+    // -pf(v) para la vuelta: las claves son dist + potencial y la condición de
+    // parada sigue siendo clave_ida + clave_vuelta >= mu.
+
+    template <IndexedGraph G, typename Heuristic = NoHeuristic, TracePolicy Trace = NullTrace>
+    PathResult<typename G::weight_type> BidirectionalSearch(const G &out, const G &incoming, int source, int target,
+                                                            Heuristic heuristic = {}, Trace &&trace = {})
+    {
+        using Weight = typename G::weight_type;
+        constexpr bool useHeuristic = !std::is_same_v<Heuristic, NoHeuristic>;
+        using Key = std::conditional_t<useHeuristic, double, Weight>;
+        constexpr Weight infinity = std::numeric_limits<Weight>::max();
+
+        PathResult<Weight> result;
+        result.source = source;
+        result.target = target;
+
+        trace.phaseBegin(TracePhase::Init);
+        const int s = out.indexOf(source);
+        const int t = out.indexOf(target);
+        if (s < 0 || t < 0)
+        {
+            trace.phaseEnd(TracePhase::Init);
+            return result;
+        }
+        if (s == t)
+        {
+            trace.phaseEnd(TracePhase::Init);
+            result.found = true;
+            result.cost = static_cast<Weight>(0);
+            result.path = {source};
+            return result;
+        }
+
+        auto potential = [&](int v) -> Key
+        {
+            if constexpr (useHeuristic)
+                return (heuristic(v, t) - heuristic(s, v)) / 2.0;
+            else
+                return static_cast<Key>(0);
+        };
+
+        struct QItem
+        {
+            Key key;
+            Weight dist;
+            int node;
+            bool operator>(const QItem &other) const { return key > other.key; }
+        };
+        using Queue = std::priority_queue<QItem, std::vector<QItem>, std::greater<QItem>>;
+
+        struct Side
+        {
+            const G *graph;
+            std::vector<Weight> dist;
+            std::vector<int> parent;
+            Queue queue;
+            int sign; // +1 ida, -1 vuelta (signo del potencial)
+        };
+
+        const std::size_t n = out.vertexCount();
+        Side forward{&out, std::vector<Weight>(n, infinity), std::vector<int>(n, -1), {}, +1};
+        Side backward{&incoming, std::vector<Weight>(n, infinity), std::vector<int>(n, -1), {}, -1};
+
+        forward.dist[s] = static_cast<Weight>(0);
+        forward.queue.push({potential(s), forward.dist[s], s});
+        backward.dist[t] = static_cast<Weight>(0);
+        backward.queue.push({-potential(t), backward.dist[t], t});
+        trace.heapPush(2);
+        trace.phaseEnd(TracePhase::Init);
+
+        trace.phaseBegin(TracePhase::Search);
+        Weight mu = infinity;
+        int meet = -1;
+
+        while (!forward.queue.empty() && !backward.queue.empty())
+        {
+            const Key topF = forward.queue.top().key;
+            const Key topB = backward.queue.top().key;
+            if (mu != infinity && static_cast<Key>(topF + topB) >= static_cast<Key>(mu))
+                break;
+
+            Side &side = topF <= topB ? forward : backward;
+            Side &other = topF <= topB ? backward : forward;
+
+            auto [key, du, u] = side.queue.top();
+            side.queue.pop();
+            if (du != side.dist[u])
+            {
+                trace.stalePop(1);
+                continue; // entrada obsoleta
+            }
+            trace.vertexSettled(1);
+
+            const auto nbrs = side.graph->neighbors(u);
+            const auto wts = side.graph->weights(u);
+            for (std::size_t k = 0; k < nbrs.size(); ++k)
+            {
+                const Weight w = wts[k];
+                if (w < static_cast<Weight>(0))
+                    continue; // peso negativo, se ignora
+                const int v = nbrs[k];
+                const Weight cand = du + w;
+                trace.edgeRelaxed(1);
+
+                if (cand < side.dist[v])
+                {
+                    side.dist[v] = cand;
+                    side.parent[v] = u;
+                    side.queue.push({static_cast<Key>(cand + side.sign * potential(v)), cand, v});
+                    trace.heapPush(1);
+                }
+                if (other.dist[v] != infinity && cand + other.dist[v] < mu)
+                {
+                    mu = cand + other.dist[v];
+                    meet = v;
+                }
+            }
+        }
+        trace.phaseEnd(TracePhase::Search);
+
+        if (meet < 0)
+            return result;
+
+        // camino: source -> meet (padres de ida) y meet -> target (padres de vuelta)
+        trace.phaseBegin(TracePhase::Finalize);
+        for (int v = meet; v != -1; v = forward.parent[v])
+            result.path.push_back(out.vertexId(v));
+        std::reverse(result.path.begin(), result.path.end());
+        for (int v = backward.parent[meet]; v != -1; v = backward.parent[v])
+            result.path.push_back(out.vertexId(v));
+        result.found = true;
+        result.cost = mu;
+        trace.phaseEnd(TracePhase::Finalize);
+        return result;
+    }
+
+    template <typename Weight = double, typename Heuristic = NoHeuristic, TracePolicy Trace = NullTrace>
+    PathResult<Weight> BidirectionalSearch(const CsrGraph<Weight> &g, int source, int target,
+                                           Heuristic heuristic = {}, Trace &&trace = {})
+    {
+        if (!g.isDirected())
+            return BidirectionalSearch(g, g, source, target, heuristic, std::forward<Trace>(trace));
+        return BidirectionalSearch(g, g.transposed(), source, target, heuristic, std::forward<Trace>(trace));
+    }
+
+    template <typename Weight = double, typename Heuristic = NoHeuristic, TracePolicy Trace = NullTrace>
+    PathResult<Weight> BidirectionalSearch(const AdjacencyListGraph<Weight> &g, int source, int target,
+                                           Heuristic heuristic = {}, Trace &&trace = {})
+    {
+        return BidirectionalSearch(CsrGraph<Weight>(g), source, target, heuristic, std::forward<Trace>(trace));
+    }
+} // namespace Algorithms
@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Phases reported by the algorithms to their trace policy.
+ */
+enum class TracePhase { Init, Search, Finalize };
+
+inline constexpr std::size_t TracePhaseCount = 3;
+
+inline const char* tracePhaseName(TracePhase phase) {
+    switch (phase) {
+        case TracePhase::Init: return "init";
+        case TracePhase::Search: return "search";
+        default: return "finalize";
+    }
+}
+
+/**
+ * @brief Compile-time instrumentation policy passed to the algorithms.
+ *
+ * Every hook takes a count so parallel algorithms can report per-thread totals
+ * in one call. Algorithms only aggregate such totals when Trace::enabled.
+ * cancelRequested() is the one hook parallel algorithms may call from inside
+ * their worker loops, so it must be safe to call from any thread.
+ */
+template <typename T>
+concept TracePolicy = requires(std::remove_cvref_t<T>& t, TracePhase phase, std::size_t n) {
+    { std::remove_cvref_t<T>::enabled } -> std::convertible_to<bool>;
+    t.phaseBegin(phase);
+    t.phaseEnd(phase);
+    t.vertexSettled(n);
+    t.edgeRelaxed(n);
+    t.heapPush(n);
+    t.stalePop(n);
+    { std::as_const(t).cancelRequested() } -> std::convertible_to<bool>;
+};
+
+/**
+ * @brief Default policy: every hook is an empty inline function.
+ */
+struct NullTrace {
+    static constexpr bool enabled = false;
+
+    void phaseBegin(TracePhase) {}
+    void phaseEnd(TracePhase) {}
+    void vertexSettled(std::size_t = 1) {}
+    void edgeRelaxed(std::size_t = 1) {}
+    void heapPush(std::size_t = 1) {}
+    void stalePop(std::size_t = 1) {}
+    bool cancelRequested() const noexcept { return false; }
+};
+
+/**
+ * @brief Opt-in policy that counts hot-path events and times each phase.
+ */
+struct CountingTrace {
+    static constexpr bool enabled = true;
+
+    std::uint64_t verticesSettled = 0;
+    std::uint64_t edgesRelaxed = 0;
+    std::uint64_t heapPushes = 0;
+    std::uint64_t stalePops = 0;
+    std::array<std::chrono::nanoseconds, TracePhaseCount> phaseTime{};
+
+    void phaseBegin(TracePhase phase) { started_[index(phase)] = Clock::now(); }
+    void phaseEnd(TracePhase phase) { phaseTime[index(phase)] += Clock::now() - started_[index(phase)]; }
+    void vertexSettled(std::size_t n = 1) { verticesSettled += n; }
+    void edgeRelaxed(std::size_t n = 1) { edgesRelaxed += n; }
+    void heapPush(std::size_t n = 1) { heapPushes += n; }
+    void stalePop(std::size_t n = 1) { stalePops += n; }
+    bool cancelRequested() const noexcept { return false; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static std::size_t index(TracePhase phase) { return static_cast<std::size_t>(phase); }
+    std::array<Clock::time_point, TracePhaseCount> started_{};
+};
+
+/**
+ * @brief Thrown out of an algorithm run by CancellableTrace once it is cancelled.
+ */
+struct OperationCancelled : std::exception {
+    const char* what() const noexcept override { return "Operation cancelled"; }
+};
+
+/**
+ * @brief Policy that makes a run cooperatively cancellable.
+ *
+ * The phase and vertexSettled() hooks check the flag and throw
+ * OperationCancelled once it is set; every hook forwards to Inner. Sequential
+ * algorithms call vertexSettled() per vertex, so they stop almost at once.
+ * Parallel ones poll cancelRequested() at their synchronization points (a
+ * Floyd-Warshall round, a delta-stepping bucket), leave their loops on all
+ * threads together and throw OperationCancelled from the calling thread. The
+ * algorithms own their state with RAII, so unwinding is safe.
+ */
+template <TracePolicy Inner = NullTrace>
+struct CancellableTrace {
+    static constexpr bool enabled = std::remove_cvref_t<Inner>::enabled;
+
+    CancellableTrace(const std::atomic<bool>& cancelled, Inner inner = {})
+        : inner(std::move(inner)), cancelled_(&cancelled) {}
+
+    void phaseBegin(TracePhase phase) { check(); inner.phaseBegin(phase); }
+    void phaseEnd(TracePhase phase) { check(); inner.phaseEnd(phase); }
+    void vertexSettled(std::size_t n = 1) { check(); inner.vertexSettled(n); }
+    void edgeRelaxed(std::size_t n = 1) { inner.edgeRelaxed(n); }
+    void heapPush(std::size_t n = 1) { inner.heapPush(n); }
+    void stalePop(std::size_t n = 1) { inner.stalePop(n); }
+    bool cancelRequested() const noexcept { return cancelled_->load(std::memory_order_relaxed) || inner.cancelRequested(); }
+
+    Inner inner;
+
+private:
+    void check() const {
+        if (cancelled_->load(std::memory_order_relaxed))
+            throw OperationCancelled();
+    }
+
+    const std::atomic<bool>* cancelled_;
+};
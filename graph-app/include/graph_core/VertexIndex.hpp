@@ -0,0 +1,157 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Translates external node IDs to dense indices in [0, n) and back.
+ *
+ * Dense indices follow the order of the ID vector given at construction. When
+ * the IDs are exactly 0..n-1 the hash map is skipped and the translation is
+ * the identity.
+ */
+class VertexIndex {
+public:
+    VertexIndex() = default;
+
+    explicit VertexIndex(std::vector<int> ids) : ids_(std::move(ids)) {
+        identity_ = true;
+        for (std::size_t i = 0; i < ids_.size(); ++i) {
+            if (ids_[i] != static_cast<int>(i)) {
+                identity_ = false;
+                break;
+            }
+        }
+        if (!identity_) {
+            lookup_.reserve(ids_.size());
+            for (std::size_t i = 0; i < ids_.size(); ++i)
+                lookup_.emplace(ids_[i], static_cast<int>(i));
+        }
+    }
+
+    std::size_t size() const { return ids_.size(); }
+
+    int id(int index) const { return ids_[index]; }
+
+    int indexOf(int id) const {
+        if (identity_)
+            return (id >= 0 && static_cast<std::size_t>(id) < ids_.size()) ? id : -1;
+        auto it = lookup_.find(id);
+        return it == lookup_.end() ? -1 : it->second;
+    }
+
+    const std::vector<int>& ids() const { return ids_; }
+
+    std::size_t memoryBytes() const {
+        std::size_t bytes = sizeof(*this) + ids_.capacity() * sizeof(int);
+        if (!identity_)
+            bytes += lookup_.bucket_count() * sizeof(void*)
+                   + lookup_.size() * (sizeof(void*) + sizeof(std::pair<const int, int>));
+        return bytes;
+    }
+
+    static const std::shared_ptr<const VertexIndex>& empty() {
+        static const auto instance = std::make_shared<const VertexIndex>();
+        return instance;
+    }
+
+private:
+    std::vector<int> ids_;
+    std::unordered_map<int, int> lookup_;
+    bool identity_ = true;
+};
+
+/**
+ * @brief Per-vertex values stored in a flat vector indexed by dense vertex index.
+ *
+ * Behaves like a read-mostly map from external node ID to T: at(), find(),
+ * count() and iteration (as std::pair<int, T>) translate through the shared
+ * VertexIndex, while algorithms write the dense vector directly. Only the
+ * vertices of the index can be looked up; at() and operator[] throw
+ * std::out_of_range for any other ID.
+ */
+template <typename T>
+class VertexMap {
+public:
+    class const_iterator {
+    public:
+        using value_type = std::pair<int, T>;
+        using difference_type = std::ptrdiff_t;
+
+        struct Arrow {
+            value_type kv;
+            const value_type* operator->() const { return &kv; }
+        };
+
+        const_iterator() = default;
+        const_iterator(const VertexMap* map, std::size_t pos) : map_(map), pos_(pos) {}
+
+        value_type operator*() const {
+            return {map_->index_->id(static_cast<int>(pos_)), map_->values_[pos_]};
+        }
+        Arrow operator->() const { return {**this}; }
+
+        const_iterator& operator++() { ++pos_; return *this; }
+        const_iterator operator++(int) { auto tmp = *this; ++pos_; return tmp; }
+        bool operator==(const const_iterator& other) const { return pos_ == other.pos_; }
+
+    private:
+        const VertexMap* map_ = nullptr;
+        std::size_t pos_ = 0;
+    };
+
+    VertexMap() : index_(VertexIndex::empty()) {}
+
+    VertexMap(std::shared_ptr<const VertexIndex> index, const T& init)
+        : index_(std::move(index)), values_(index_->size(), init) {}
+
+    std::size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+
+    bool contains(int id) const { return index_->indexOf(id) >= 0; }
+    std::size_t count(int id) const { return contains(id) ? 1 : 0; }
+
+    const T& at(int id) const { return values_[checkedIndex(id)]; }
+    T& at(int id) { return values_[checkedIndex(id)]; }
+    T& operator[](int id) { return at(id); }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, values_.size()}; }
+    const_iterator find(int id) const {
+        int u = index_->indexOf(id);
+        return u < 0 ? end() : const_iterator(this, static_cast<std::size_t>(u));
+    }
+
+    std::vector<T>& dense() { return values_; }
+    const std::vector<T>& dense() const { return values_; }
+
+    const VertexIndex& index() const { return *index_; }
+    const std::shared_ptr<const VertexIndex>& sharedIndex() const { return index_; }
+
+    friend bool operator==(const VertexMap& a, const VertexMap& b) {
+        if (a.size() != b.size())
+            return false;
+        if (a.index_ == b.index_)
+            return a.values_ == b.values_;
+        for (std::size_t u = 0; u < a.values_.size(); ++u) {
+            int v = b.index_->indexOf(a.index_->id(static_cast<int>(u)));
+            if (v < 0 || !(b.values_[v] == a.values_[u]))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    std::size_t checkedIndex(int id) const {
+        int u = index_->indexOf(id);
+        if (u < 0)
+            throw std::out_of_range("VertexMap: unknown node id");
+        return static_cast<std::size_t>(u);
+    }
+
+    std::shared_ptr<const VertexIndex> index_;
+    std::vector<T> values_;
+};
@@ -1,220 +1,266 @@
 #pragma once
 #include "GraphStorage.hpp"
-#include <queue>
+#include "GraphConcepts.hpp"
+#include "CsrGraph.hpp"
+#include "VertexIndex.hpp"
+#include "Trace.hpp"
+#include "PriorityQueue.hpp"
+#include <algorithm>
 #include <stack>
 #include <limits>
-#include <unordered_map>
 #include <vector>
 #include <optional>
-#include <iostream>
+#include <utility>
 
 // ---------- Resultados estructurados ----------
+// Los resultados por nodo son VertexMap: vectores densos indexados por el índice
+// del vértice que comparten el VertexIndex del grafo para traducir a IDs externos.
 
 struct TraversalResult
 {
     int source = -1;
-    std::vector<int> order;              // orden de visita
-    std::unordered_map<int, int> parent; // padre de cada nodo (o -1)
-    std::unordered_map<int, int> depth;  // distancia en saltos desde source
+    std::vector<int> order; // orden de visita
+    VertexMap<int> parent;  // padre de cada nodo (o -1)
+    VertexMap<int> depth;   // distancia en saltos desde source
 };
 
 template <typename Weight>
 struct DijkstraResult
 {
     int source = -1;
-    std::unordered_map<int, Weight> dist; // distancia mínima desde source
-    std::unordered_map<int, int> parent;  // predecesor en el camino más corto
+    VertexMap<Weight> dist; // distancia mínima desde source
+    VertexMap<int> parent;  // predecesor en el camino más corto
 };
 
 namespace Algorithms
 {
+    // Todos los algoritmos trabajan sobre cualquier IndexedGraph (p. ej. CsrGraph).
+    // Las sobrecargas para AdjacencyListGraph construyen un CsrGraph temporal; para
+    // consultas repetidas conviene construir el CsrGraph una sola vez.
+    //
+    // El último parámetro es una política de instrumentación (Trace.hpp). Por
+    // defecto es NullTrace, cuyas llamadas no generan código; con CountingTrace
+    // se obtienen contadores y tiempos por fase de una ejecución concreta.
+
     // ---------- BFS ----------
 
-    template <typename Weight = double>
-    TraversalResult BFS(const AdjacencyListGraph<Weight> &graph, int source)
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    TraversalResult BFS(const G &graph, int source, Trace &&trace = {})
     {
         TraversalResult result;
         result.source = source;
 
-        std::queue<int> fifo_queue;
-        std::unordered_map<int, bool> seen;
-
         // inicialización
-        for (const auto &[id, _] : graph.getAdjList())
-        {
-            result.parent[id] = -1;
-            result.depth[id] = std::numeric_limits<int>::max();
-        }
-        if (!graph.getAdjList().count(source))
+        trace.phaseBegin(TracePhase::Init);
+        const int n = static_cast<int>(graph.vertexCount());
+        result.parent = VertexMap<int>(graph.sharedVertexIndex(), -1);
+        result.depth = VertexMap<int>(graph.sharedVertexIndex(), std::numeric_limits<int>::max());
+        auto &parent = result.parent.dense();
+        auto &depth = result.depth.dense();
+
+        const int s = graph.indexOf(source);
+        trace.phaseEnd(TracePhase::Init);
+        if (s < 0)
             return result;
 
-        seen[source] = true;
-        result.depth[source] = 0;
-        fifo_queue.push(source);
+        // depth == max marca los nodos no vistos; la cola es el propio vector order
+        trace.phaseBegin(TracePhase::Search);
+        std::vector<int> fifo_queue;
+        fifo_queue.reserve(n);
+        depth[s] = 0;
+        fifo_queue.push_back(s);
 
-        while (!fifo_queue.empty())
+        for (std::size_t head = 0; head < fifo_queue.size(); ++head)
         {
-            int visiting_node = fifo_queue.front();
-            fifo_queue.pop();
-            result.order.push_back(visiting_node);
-            for (const auto &[neighbour_node_id, weight] : graph.getAdjList().at(visiting_node))
+            int visiting_node = fifo_queue[head];
+            trace.vertexSettled(1);
+            trace.edgeRelaxed(graph.neighbors(visiting_node).size());
+            for (int neighbour_node : graph.neighbors(visiting_node))
             {
-                (void)weight; // no se usan pesos en BFS
-                if (!seen[neighbour_node_id])
+                if (depth[neighbour_node] == std::numeric_limits<int>::max())
                 {
-                    seen[neighbour_node_id] = true;
-                    result.parent[neighbour_node_id] = visiting_node;
-                    result.depth[neighbour_node_id] = result.depth[visiting_node] + 1;
-                    fifo_queue.push(neighbour_node_id);
+                    depth[neighbour_node] = depth[visiting_node] + 1;
+                    parent[neighbour_node] = graph.vertexId(visiting_node);
+                    fifo_queue.push_back(neighbour_node);
                 }
             }
         }
+
+        trace.phaseEnd(TracePhase::Search);
+
+        trace.phaseBegin(TracePhase::Finalize);
+        result.order.resize(fifo_queue.size());
+        for (std::size_t i = 0; i < fifo_queue.size(); ++i)
+            result.order[i] = graph.vertexId(fifo_queue[i]);
+        trace.phaseEnd(TracePhase::Finalize);
         return result;
     }
 
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    TraversalResult BFS(const AdjacencyListGraph<Weight> &graph, int source, Trace &&trace = {})
+    {
+        return BFS(CsrGraph<Weight>(graph), source, std::forward<Trace>(trace));
+    }
+
     // ---------- DFS (iterativa para evitar stack profundo) ----------
 
-    template <typename Weight = double>
-    TraversalResult DFS(const AdjacencyListGraph<Weight> &g, int source)
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    TraversalResult DFS(const G &g, int source, Trace &&trace = {})
     {
         TraversalResult r;
         r.source = source;
-        std::unordered_map<int, bool> seen;
-        for (const auto &[u, _] : g.getAdjList())
-        {
-            r.parent[u] = -1;
-            r.depth[u] = std::numeric_limits<int>::max();
-        }
-        if (!g.getAdjList().count(source))
+
+        trace.phaseBegin(TracePhase::Init);
+        const int n = static_cast<int>(g.vertexCount());
+        r.parent = VertexMap<int>(g.sharedVertexIndex(), -1);
+        r.depth = VertexMap<int>(g.sharedVertexIndex(), std::numeric_limits<int>::max());
+        auto &parent = r.parent.dense();
+        auto &depth = r.depth.dense();
+
+        const int s = g.indexOf(source);
+        trace.phaseEnd(TracePhase::Init);
+        if (s < 0)
             return r;
 
-        std::stack<std::pair<int, int>> st; // (nodo, depth)
-        st.push({source, 0});
+        trace.phaseBegin(TracePhase::Search);
+        std::vector<char> seen(n, 0);
+        std::vector<char> has_parent(n, 0);
+        std::stack<std::pair<int, int>, std::vector<std::pair<int, int>>> st; // (nodo, depth)
+        st.push({s, 0});
         while (!st.empty())
         {
             auto [u, d] = st.top();
             st.pop();
             if (seen[u])
+            {
+                trace.stalePop(1);
                 continue;
-            seen[u] = true;
-            r.order.push_back(u);
-            r.depth[u] = d;
+            }
+            seen[u] = 1;
+            r.order.push_back(g.vertexId(u));
+            depth[u] = d;
+            trace.vertexSettled(1);
 
             // para obtener un orden similar al recursivo, empujamos vecinos en orden inverso
-            const auto &nbrs = g.getAdjList().at(u);
+            const auto nbrs = g.neighbors(u);
+            trace.edgeRelaxed(nbrs.size());
             for (auto it = nbrs.rbegin(); it != nbrs.rend(); ++it)
             {
-                int v = it->first;
+                int v = *it;
                 if (!seen[v])
                 {
-                    if (r.parent[v] == -1)
-                        r.parent[v] = u;
+                    if (!has_parent[v])
+                    {
+                        has_parent[v] = 1;
+                        parent[v] = g.vertexId(u);
+                    }
                     st.push({v, d + 1});
+                    trace.heapPush(1);
                 }
             }
         }
+        trace.phaseEnd(TracePhase::Search);
         return r;
     }
 
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    TraversalResult DFS(const AdjacencyListGraph<Weight> &g, int source, Trace &&trace = {})
+    {
+        return DFS(CsrGraph<Weight>(g), source, std::forward<Trace>(trace));
+    }
+
     // ---------- Dijkstra ----------
+    //
+    // La cola de prioridad se elige en compilación según el tipo del peso
+    // (PriorityQueue.hpp): con pesos enteros, un radix heap, que solo hace
+    // inserciones en vectores y un bit_width por entrada; con pesos reales, un
+    // heap 4-ario. En ambos casos las entradas obsoletas se descartan al sacarlas.
+    // Con empates de distancia, el predecesor elegido depende de la cola.
 
-    template <typename Weight = double>
-    DijkstraResult<Weight> Dijkstra(const AdjacencyListGraph<Weight> &g, int source)
+    template <IndexedGraph G, TracePolicy Trace = NullTrace>
+    DijkstraResult<typename G::weight_type> Dijkstra(const G &g, int source, Trace &&trace = {})
     {
+        using Weight = typename G::weight_type;
         DijkstraResult<Weight> r;
         r.source = source;
 
-        struct QItem
-        {
-            int node;
-            Weight dist;
-            bool operator>(const QItem &other) const { return dist > other.dist; }
-        };
-
         // init
-        std::cout << "Inicializando nodos...\n";
-        for (const auto& [node, _] : g.getAdjList())
-        {
+        trace.phaseBegin(TracePhase::Init);
+        r.dist = VertexMap<Weight>(g.sharedVertexIndex(), std::numeric_limits<Weight>::max());
+        r.parent = VertexMap<int>(g.sharedVertexIndex(), -1);
+        auto &dist = r.dist.dense();
+        auto &parent = r.parent.dense();
+        const int s = g.indexOf(source);
+        trace.phaseEnd(TracePhase::Init);
 
-            r.dist[node] = std::numeric_limits<Weight>::max();
-            r.parent[node] = -1;
-            std::cout << "Nodo " << node 
-              << ": dist = " << r.dist[node] 
-              << ", parent = " << r.parent[node] << "\n";
-        }
+        if (s < 0)
+            return r; // el nodo fuente no está en el grafo
 
-        if (!g.getAdjList().count(source))
-        {
-            std::cout << "El nodo fuente " << source << " no está en el grafo.\n";
-            return r;
-        }
+        trace.phaseBegin(TracePhase::Search);
+        dist[s] = static_cast<Weight>(0);
 
-        r.dist[source] = static_cast<Weight>(0);
-        std::cout << "Nodo fuente " << source << ": dist = 0\n";
-
-        std::priority_queue<QItem, std::vector<QItem>, std::greater<QItem>> pq;
-        pq.push({source, r.dist[source]});
+        MonotoneQueue<Weight> pq;
+        pq.push(dist[s], s);
+        trace.heapPush(1);
 
         while (!pq.empty())
         {
-            auto [u, du] = pq.top();
-            pq.pop();
-            std::cout << "Procesando nodo " << u << " con dist=" << du << "\n";
+            const auto [du, u] = pq.pop();
 
-            if (du != r.dist[u])
+            if (du != dist[u])
             {
-                std::cout << "Entrada obsoleta, saltando\n";
+                trace.stalePop(1);
                 continue; // entrada obsoleta
             }
+            trace.vertexSettled(1);
 
-            for (const auto &[v, w] : g.getAdjList().at(u))
+            const auto nbrs = g.neighbors(u);
+            const auto wts = g.weights(u);
+            for (std::size_t k = 0; k < nbrs.size(); ++k)
             {
-                std::cout << "  Arista " << u << " -> " << v << " peso=" << w << "\n";
-
+                const int v = nbrs[k];
+                const Weight w = wts[k];
                 if (w < static_cast<Weight>(0))
-                {
-                    std::cout << "  Peso negativo, ignorando\n";
-                    continue;
-                }
-
-                Weight cand = r.dist[u] + w;
-                std::cout << "  dist[" << u << "] + w = " << r.dist[u] << " + " << w
-                        << " = " << cand << ", dist[" << v << "] = " << r.dist[v] << "\n";
+                    continue; // peso negativo, se ignora
 
-                if (cand < r.dist[v])
+                trace.edgeRelaxed(1);
+                Weight cand = dist[u] + w;
+                if (cand < dist[v])
                 {
-                    std::cout << "  Actualizando dist[" << v << "] de " << r.dist[v]
-                            << " a " << cand << ", parent[" << v << "] = " << u << "\n";
-                    r.dist[v] = cand;
-                    r.parent[v] = u;
-                    pq.push({v, cand});
+                    dist[v] = cand;
+                    parent[v] = g.vertexId(u);
+                    pq.push(cand, v);
+                    trace.heapPush(1);
                 }
             }
         }
-
-        std::cout << "Dijkstra finalizado.\n";
-        for (const auto& [node, dist] : r.dist)
-            std::cout << "Nodo " << node << ": dist=" << dist << ", parent=" << r.parent[node] << "\n";
+        trace.phaseEnd(TracePhase::Search);
 
         return r;
     }
 
+    template <typename Weight = double, TracePolicy Trace = NullTrace>
+    DijkstraResult<Weight> Dijkstra(const AdjacencyListGraph<Weight> &g, int source, Trace &&trace = {})
+    {
+        return Dijkstra(CsrGraph<Weight>(g), source, std::forward<Trace>(trace));
+    }
+
     // ---------- reconstrucción de camino (opcional de ayuda) ----------
 
     template <typename Weight = double>
-    std::vector<int> ReconstructPath(int target, const std::unordered_map<int, int> &parent)
+    std::vector<int> ReconstructPath(int target, const VertexMap<int> &parent)
     {
         std::vector<int> path;
-        if (!parent.count(target))
+        if (!parent.contains(target))
             return path;
         int cur = target;
         while (cur != -1)
         {
             path.push_back(cur);
-            auto it = parent.find(cur);
-            if (it == parent.end())
+            int u = parent.index().indexOf(cur);
+            if (u < 0)
                 break;
-            cur = it->second;
+            cur = parent.dense()[u];
         }
         std::reverse(path.begin(), path.end());
         return path;
@@ -0,0 +1,322 @@
+#pragma once
+#include "graph_core/CsrGraph.hpp"
+#include "graph_core/GraphStorage.hpp"
+#include "graph_core/VertexIndex.hpp"
+#include "graph_core/VertexOrder.hpp"
+#include "graph_repository/GraphSpill.hpp"
+#include "graph_repository/MappedFile.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Versioned binary graph file that is used in place through a memory mapping.
+ *
+ * Layout: a fixed Header followed by sections, each starting on a 64-byte
+ * boundary so the arrays can be viewed directly with their natural alignment:
+ *
+ *   ids            int32[n]       external ID of each dense vertex
+ *   offsets        uint64[n + 1]  CSR offsets
+ *   neighbors      int32[m]       dense targets
+ *   weights        Weight[m]
+ *   reverse*       same three arrays for the transpose (directed lists only)
+ *   labelOffsets   uint64[n + 1]  label of u is labelBytes[labelOffsets[u] .. labelOffsets[u + 1])
+ *   labelBytes     char[]
+ *
+ * Values are in host byte order; the header records it and a file written on
+ * a machine with the other order is rejected. Opening a file only checks the
+ * header and section bounds: the edge arrays are paged in by the OS as the
+ * algorithms touch them.
+ */
+namespace GraphFile {
+
+static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "CSR offsets are stored as 64-bit values");
+
+inline constexpr char magic[8] = {'G', 'R', 'A', 'P', 'H', 'C', 'S', 'R'};
+inline constexpr std::uint32_t formatVersion = 1;
+inline constexpr std::uint32_t byteOrderMark = 0x01020304;
+inline constexpr std::uint64_t alignment = 64;
+
+struct Section {
+    std::uint64_t offset = 0;
+    std::uint64_t bytes = 0;
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t formatVersion;
+    std::uint32_t byteOrder;
+    GraphSpill::GraphKind kind;
+    std::uint8_t weightTag; // GraphSpill::weightTag<Weight>()
+    std::uint8_t directed;
+    VertexOrder vertexOrder; // order of the dense vertices (Original in files written before it existed)
+    std::uint8_t reserved[4];
+    std::uint64_t graphVersion;
+    std::uint64_t vertexCount;
+    std::uint64_t edgeCount;
+    Section ids;
+    Section offsets;
+    Section neighbors;
+    Section weights;
+    Section reverseOffsets;
+    Section reverseNeighbors;
+    Section reverseWeights;
+    Section labelOffsets;
+    Section labelBytes;
+};
+static_assert(std::is_trivially_copyable_v<Header>);
+
+/**
+ * @brief Read-only graph backed by a mapped graph file.
+ *
+ * csr() and reverse() view the mapped arrays without copying them; only the
+ * vertex index (ID -> dense index) is built in memory when the file is opened.
+ */
+template<typename Weight>
+class MappedGraph {
+public:
+    using weight_type = Weight;
+
+    explicit MappedGraph(const std::filesystem::path& path)
+        : source_(path), file_(std::make_shared<const MappedFile>(path)) {
+        if (file_->size() < sizeof(Header)) {
+            throw std::runtime_error("Not a graph file: " + path.string());
+        }
+        std::memcpy(&header_, file_->data(), sizeof(Header));
+        if (!std::equal(header_.magic, header_.magic + sizeof(magic), magic)) {
+            throw std::runtime_error("Not a graph file: " + path.string());
+        }
+        if (header_.formatVersion != formatVersion || header_.byteOrder != byteOrderMark) {
+            throw std::runtime_error("Unsupported graph file format: " + path.string());
+        }
+        if (header_.weightTag != GraphSpill::weightTag<Weight>()) {
+            throw std::runtime_error("Graph file has a different weight type: " + path.string());
+        }
+        if (header_.vertexOrder > VertexOrder::Rabbit) {
+            throw std::runtime_error("Corrupt graph file: " + path.string());
+        }
+
+        const std::uint64_t n = header_.vertexCount, m = header_.edgeCount;
+        auto ids = section<std::int32_t>(header_.ids, n);
+        auto offsets = section<std::size_t>(header_.offsets, n + 1);
+        auto neighbors = section<int>(header_.neighbors, m);
+        auto weights = section<Weight>(header_.weights, m);
+        labelOffsets_ = section<std::uint64_t>(header_.labelOffsets, n + 1);
+        labelBytes_ = section<char>(header_.labelBytes, header_.labelBytes.bytes);
+        if (offsets.front() != 0 || offsets.back() != m || labelOffsets_.front() != 0
+            || labelOffsets_.back() != labelBytes_.size()) {
+            throw std::runtime_error("Corrupt graph file: " + path.string());
+        }
+
+        auto index = std::make_shared<const VertexIndex>(std::vector<int>(ids.begin(), ids.end()));
+        csr_ = CsrGraph<Weight>::view(header_.directed != 0, index, offsets, neighbors, weights, file_);
+        if (header_.reverseOffsets.bytes != 0) {
+            auto reverseOffsets = section<std::size_t>(header_.reverseOffsets, n + 1);
+            if (reverseOffsets.front() != 0 || reverseOffsets.back() != m) {
+                throw std::runtime_error("Corrupt graph file: " + path.string());
+            }
+            reverse_ = CsrGraph<Weight>::view(header_.directed != 0, index, reverseOffsets,
+                                              section<int>(header_.reverseNeighbors, m),
+                                              section<Weight>(header_.reverseWeights, m), file_);
+            hasReverse_ = true;
+        }
+    }
+
+    GraphSpill::GraphKind kind() const { return header_.kind; }
+    std::uint64_t graphVersion() const { return header_.graphVersion; }
+    bool isDirected() const { return header_.directed != 0; }
+    VertexOrder vertexOrder() const { return header_.vertexOrder; }
+
+    const CsrGraph<Weight>& csr() const { return csr_; }
+
+    // Transpose stored in the file, or nullptr if it has none.
+    const CsrGraph<Weight>* reverse() const { return hasReverse_ ? &reverse_ : nullptr; }
+
+    // Label of dense vertex u.
+    std::string_view label(int u) const {
+        return {labelBytes_.data() + labelOffsets_[u], labelOffsets_[u + 1] - labelOffsets_[u]};
+    }
+
+    const std::filesystem::path& source() const { return source_; }
+
+    // Heap bytes only; the mapped file lives in the page cache.
+    std::size_t memoryBytes() const {
+        return sizeof(*this) + csr_.vertexIndex().memoryBytes();
+    }
+
+private:
+    template<typename T>
+    std::span<const T> section(const Section& s, std::uint64_t count) const {
+        if (s.offset % alignment != 0 || s.bytes != count * sizeof(T) || s.offset > file_->size()
+            || s.bytes > file_->size() - s.offset) {
+            throw std::runtime_error("Corrupt graph file: " + source_.string());
+        }
+        return {reinterpret_cast<const T*>(file_->data() + s.offset), static_cast<std::size_t>(count)};
+    }
+
+    std::filesystem::path source_;
+    std::shared_ptr<const MappedFile> file_;
+    Header header_{};
+    CsrGraph<Weight> csr_;
+    CsrGraph<Weight> reverse_;
+    bool hasReverse_ = false;
+    std::span<const std::uint64_t> labelOffsets_;
+    std::span<const char> labelBytes_;
+};
+
+/**
+ * @brief Writes a graph file for csr (and its transpose, if given); labelOf(u)
+ * returns the label of dense vertex u.
+ *
+ * The file is written next to path and renamed over it, so a reader mapping
+ * the old file keeps a consistent view.
+ */
+template<typename Weight, typename LabelOf>
+void write(const std::filesystem::path& path, GraphSpill::GraphKind kind, std::uint64_t graphVersion,
+           VertexOrder vertexOrder, const CsrGraph<Weight>& csr, const CsrGraph<Weight>* reverse, LabelOf&& labelOf) {
+    const std::size_t n = csr.vertexCount();
+
+    std::vector<std::uint64_t> labelOffsets(n + 1, 0);
+    std::string labelBytes;
+    for (std::size_t u = 0; u < n; ++u) {
+        labelBytes += labelOf(static_cast<int>(u));
+        labelOffsets[u + 1] = labelBytes.size();
+    }
+
+    Header header{};
+    std::copy(magic, magic + sizeof(magic), header.magic);
+    header.formatVersion = formatVersion;
+    header.byteOrder = byteOrderMark;
+    header.kind = kind;
+    header.weightTag = GraphSpill::weightTag<Weight>();
+    header.directed = csr.isDirected() ? 1 : 0;
+    header.vertexOrder = vertexOrder;
+    header.graphVersion = graphVersion;
+    header.vertexCount = n;
+    header.edgeCount = csr.edgeCount();
+
+    std::uint64_t end = sizeof(Header);
+    auto place = [&](Section& s, std::uint64_t bytes) {
+        s.offset = (end + alignment - 1) / alignment * alignment;
+        s.bytes = bytes;
+        end = s.offset + bytes;
+    };
+    place(header.ids, n * sizeof(std::int32_t));
+    place(header.offsets, (n + 1) * sizeof(std::uint64_t));
+    place(header.neighbors, csr.edgeCount() * sizeof(int));
+    place(header.weights, csr.edgeCount() * sizeof(Weight));
+    if (reverse) {
+        place(header.reverseOffsets, (n + 1) * sizeof(std::uint64_t));
+        place(header.reverseNeighbors, reverse->edgeCount() * sizeof(int));
+        place(header.reverseWeights, reverse->edgeCount() * sizeof(Weight));
+    }
+    place(header.labelOffsets, (n + 1) * sizeof(std::uint64_t));
+    place(header.labelBytes, labelBytes.size());
+
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot create " + temporary.string());
+        }
+        std::uint64_t written = 0;
+        auto emit = [&](const Section& s, const void* data) {
+            static constexpr char zeros[alignment] = {};
+            out.write(zeros, static_cast<std::streamsize>(s.offset - written));
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(s.bytes));
+            written = s.offset + s.bytes;
+        };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        written = sizeof(Header);
+
+        const auto& ids = csr.vertexIndex().ids();
+        emit(header.ids, ids.data());
+        emit(header.offsets, csr.offsets().data());
+        emit(header.neighbors, csr.neighborArray().data());
+        emit(header.weights, csr.weightArray().data());
+        if (reverse) {
+            emit(header.reverseOffsets, reverse->offsets().data());
+            emit(header.reverseNeighbors, reverse->neighborArray().data());
+            emit(header.reverseWeights, reverse->weightArray().data());
+        }
+        emit(header.labelOffsets, labelOffsets.data());
+        emit(header.labelBytes, labelBytes.data());
+        if (!out.flush()) {
+            throw std::runtime_error("Failed to write " + temporary.string());
+        }
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+template<typename Weight>
+void write(const std::filesystem::path& path, const AdjacencyListGraph<Weight>& graph, const CsrGraph<Weight>& csr,
+           const CsrGraph<Weight>* reverse, std::uint64_t graphVersion, VertexOrder vertexOrder = VertexOrder::Original) {
+    const auto& labels = graph.getNodeLabels();
+    write(path, GraphSpill::GraphKind::AdjacencyList, graphVersion, vertexOrder, csr, reverse, [&](int u) -> std::string_view {
+        auto it = labels.find(csr.vertexId(u));
+        return it == labels.end() ? std::string_view() : std::string_view(it->second);
+    });
+}
+
+template<typename Weight>
+void write(const std::filesystem::path& path, const AdjacencyMatrixGraph<Weight>& graph, std::uint64_t graphVersion) {
+    const CsrGraph<Weight> csr(graph);
+    const auto& labels = graph.getNodeLabels();
+    write(path, GraphSpill::GraphKind::AdjacencyMatrix, graphVersion, VertexOrder::Original, csr, static_cast<const CsrGraph<Weight>*>(nullptr),
+          [&](int u) -> std::string_view { return labels[u]; });
+}
+
+template<typename Weight>
+void write(const std::filesystem::path& path, const MappedGraph<Weight>& graph) {
+    write(path, graph.kind(), graph.graphVersion(), graph.vertexOrder(), graph.csr(), graph.reverse(),
+          [&](int u) { return graph.label(u); });
+}
+
+// Matrix graph stored in a graph file of kind AdjacencyMatrix (dense, so it is copied out).
+template<typename Weight>
+AdjacencyMatrixGraph<Weight> toMatrix(const MappedGraph<Weight>& mapped) {
+    const auto& csr = mapped.csr();
+    AdjacencyMatrixGraph<Weight> graph(csr.vertexCount(), csr.isDirected());
+    for (std::size_t u = 0; u < csr.vertexCount(); ++u) {
+        const int i = static_cast<int>(u);
+        graph.addNode(i, mapped.label(i));
+        const auto neighbors = csr.neighbors(i);
+        const auto weights = csr.weights(i);
+        for (std::size_t k = 0; k < neighbors.size(); ++k)
+            graph.addEdge(i, neighbors[k], weights[k]);
+    }
+    return graph;
+}
+
+// Adjacency list stored in a graph file, copied out so it can be modified. Arcs are restored
+// verbatim, so an undirected graph keeps each edge in both directions as written.
+template<typename Weight>
+AdjacencyListGraph<Weight> toList(const MappedGraph<Weight>& mapped) {
+    const auto& csr = mapped.csr();
+    AdjacencyListGraph<Weight> graph(csr.isDirected());
+    graph.reserve(csr.vertexCount());
+    for (std::size_t u = 0; u < csr.vertexCount(); ++u) {
+        const int i = static_cast<int>(u);
+        const int id = csr.vertexId(i);
+        graph.addNode(id, mapped.label(i));
+        const auto neighbors = csr.neighbors(i);
+        const auto weights = csr.weights(i);
+        graph.reserveEdges(id, neighbors.size());
+        for (std::size_t k = 0; k < neighbors.size(); ++k)
+            graph.addArc(id, csr.vertexId(neighbors[k]), weights[k]);
+    }
+    return graph;
+}
+
+} // namespace GraphFile
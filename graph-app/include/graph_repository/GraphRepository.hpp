@@ -1,29 +1,671 @@
 #pragma once
 #include "graph_core/GraphStorage.hpp"
+#include "graph_core/CsrGraph.hpp"
+#include "graph_core/ContractionHierarchy.hpp"
+#include "graph_core/VertexOrder.hpp"
+#include "graph_repository/GraphFile.hpp"
+#include "graph_repository/GraphSpill.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <system_error>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
 
+/**
+ * @brief Thread-safe store of graphs published as immutable, versioned snapshots.
+ *
+ * Each graph id owns a slot whose current snapshot is swapped atomically
+ * (read-copy-update): readers load the snapshot once and keep it alive for as
+ * long as they use it, so an in-flight algorithm run sees the version it
+ * started with even if a writer publishes a new one meanwhile. The id -> slot
+ * map is only locked exclusively to add or remove ids; lookups take a shared
+ * lock and never wait on graph construction, which happens outside the lock.
+ *
+ * Every snapshot knows its approximate size in bytes. With a memory budget set,
+ * publishing or reloading a graph that takes the resident total over the
+ * budget spills the least recently used graphs to files in the spill
+ * directory; snapshot() reloads a spilled graph transparently. The budget is
+ * soft: the graph just touched is never evicted, and snapshots still held by
+ * readers are freed only when the last reader lets go.
+ *
+ * An adjacency list can be stored with its CSR form in a cache-friendlier
+ * vertex order (VertexOrder.hpp). The order belongs to the graph id: new
+ * versions, reloads from the spill file and graph files keep it.
+ *
+ * saveAll() writes every graph as a graph file (GraphFile.hpp) and loadAll()
+ * maps them back at startup: adjacency lists come back as read-only
+ * GraphFile::MappedGraph snapshots that serve CSR queries straight from the
+ * mapping, without parsing or rebuilding anything but the vertex index.
+ */
 class GraphRepository {
-private:
-    int nextId = 0;
-    std::unordered_map<int, std::shared_ptr<void>> graphs;
+    struct Codec; // type-specific spill and persistence functions, see CodecFor
 
 public:
+    /**
+     * @brief One immutable version of a stored graph and its derived forms.
+     */
+    class Snapshot {
+    public:
+        std::uint64_t version() const { return version_; }
+
+        // Approximate heap bytes of the graph, its CSR form and the transpose.
+        std::size_t memoryBytes() const { return bytes_; }
+
+        // Order of the dense vertices of the CSR forms; Original for matrices.
+        VertexOrder vertexOrder() const { return order_; }
+
+        template<typename GraphT>
+        bool holds() const {
+            return type_ == typeid(GraphT);
+        }
+
+        template<typename GraphT>
+        const GraphT& graph() const {
+            if (!holds<GraphT>()) {
+                throw std::runtime_error("Graph has a different type");
+            }
+            return *std::static_pointer_cast<const GraphT>(graph_);
+        }
+
+        template<typename Weight>
+        bool hasCsr() const {
+            return csr_ && csrType_ == typeid(CsrGraph<Weight>);
+        }
+
+        template<typename Weight>
+        const CsrGraph<Weight>& csr() const {
+            if (!hasCsr<Weight>()) {
+                throw std::runtime_error("Graph has no CSR form");
+            }
+            return *std::static_pointer_cast<const CsrGraph<Weight>>(csr_);
+        }
+
+        // Incoming edges of every vertex; for undirected graphs this is the CSR graph itself.
+        template<typename Weight>
+        const CsrGraph<Weight>& reverseCsr() const {
+            if (!reverseCsr_) {
+                return csr<Weight>();
+            }
+            csr<Weight>(); // type check
+            return *std::static_pointer_cast<const CsrGraph<Weight>>(reverseCsr_);
+        }
+
+    private:
+        friend class GraphRepository;
+
+        std::uint64_t version_ = 0;
+        std::size_t bytes_ = 0;
+        VertexOrder order_ = VertexOrder::Original;
+        const Codec* codec_ = nullptr;
+        std::type_index type_ = typeid(void); // concrete type behind graph_
+        std::shared_ptr<const void> graph_;
+        // CSR form of an adjacency list (built or mapped) and its transpose (only for directed graphs).
+        std::type_index csrType_ = typeid(void);
+        std::shared_ptr<const void> csr_;
+        std::shared_ptr<const void> reverseCsr_;
+    };
+
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    GraphRepository() : GraphRepository(0) {}
+
+    /**
+     * @param memoryBudget   resident bytes allowed before graphs are spilled; 0 = unlimited
+     * @param spillDirectory parent of this repository's spill files; empty = system temp directory
+     */
+    explicit GraphRepository(std::size_t memoryBudget, const std::filesystem::path& spillDirectory = {})
+        : budgetBytes(memoryBudget),
+          spillDir((spillDirectory.empty() ? std::filesystem::temp_directory_path() : spillDirectory)
+                   / ("graph-repository-" + std::to_string(std::random_device{}()))) {}
+
+    GraphRepository(const GraphRepository&) = delete;
+    GraphRepository& operator=(const GraphRepository&) = delete;
+
+    ~GraphRepository() {
+        std::error_code ignored;
+        std::filesystem::remove_all(spillDir, ignored);
+    }
+
+    // order only applies to adjacency lists; other graphs keep VertexOrder::Original.
     template<typename GraphT>
-    int addGraph(GraphT&& graph) {
-        int id = nextId++;
-        graphs[id] = std::make_shared<GraphT>(std::move(graph));
+    int addGraph(GraphT&& graph, VertexOrder order = VertexOrder::Original) {
+        auto snap = makeSnapshot(std::forward<GraphT>(graph), order);
+        int id = nextId.fetch_add(1, std::memory_order_relaxed);
+        insert(id, std::move(snap));
         return id;
     }
 
+    // Publishes a new version of graph id, in the vertex order the id was added with.
+    // Readers holding the previous snapshot keep it.
     template<typename GraphT>
-    GraphT& getGraph(int id) {
+    std::uint64_t updateGraph(int id, GraphT&& graph) {
+        auto slot = findSlot(id);
+        auto snap = makeSnapshot(std::forward<GraphT>(graph), slot->order);
+
+        std::uint64_t version;
+        {
+            std::lock_guard writer(slot->writeMutex);
+            if (slot->removed) {
+                throw std::runtime_error("Graph not found");
+            }
+            version = snap->version_ = ++slot->version;
+            residentTotal += snap->memoryBytes();
+            if (slot->current.load()) {
+                residentTotal -= slot->graphBytes;
+            }
+            dropIndex(*slot);
+            slot->graphBytes = snap->memoryBytes();
+            slot->codec = snap->codec_;
+            slot->current.store(std::move(snap));
+        }
+        touch(*slot);
+        enforceBudget(slot.get());
+        return version;
+    }
+
+    bool removeGraph(int id) {
+        std::shared_ptr<Slot> slot;
+        {
+            std::unique_lock lock(mutex);
+            auto it = graphs.find(id);
+            if (it == graphs.end()) {
+                return false;
+            }
+            slot = std::move(it->second);
+            graphs.erase(it);
+        }
+
+        std::lock_guard writer(slot->writeMutex);
+        slot->removed = true;
+        if (slot->current.load()) {
+            residentTotal -= slot->graphBytes;
+            slot->current.store(nullptr);
+        }
+        dropIndex(*slot);
+        if (slot->spilledVersion) {
+            std::error_code ignored;
+            std::filesystem::remove(spillPath(id), ignored);
+        }
+        return true;
+    }
+
+    bool contains(int id) const {
+        std::shared_lock lock(mutex);
+        return graphs.count(id) > 0;
+    }
+
+    // Current version of graph id; hold on to it for the duration of a request.
+    // Reloads the graph from its spill file if it was evicted.
+    SnapshotPtr snapshot(int id) const {
+        auto slot = findSlot(id);
+        touch(*slot);
+        if (auto snap = slot->current.load()) {
+            return snap;
+        }
+        return reload(*slot);
+    }
+
+    std::vector<int> ids() const {
+        std::shared_lock lock(mutex);
+        std::vector<int> result;
+        result.reserve(graphs.size());
+        for (const auto& [id, _] : graphs) {
+            result.push_back(id);
+        }
+        return result;
+    }
+
+    template<typename GraphT>
+    bool holds(int id) const {
+        return snapshot(id)->holds<GraphT>();
+    }
+
+    // The returned pointers share ownership of the snapshot they come from.
+    template<typename GraphT>
+    std::shared_ptr<const GraphT> getGraph(int id) const {
+        auto snap = snapshot(id);
+        return {snap, &snap->graph<GraphT>()};
+    }
+
+    template<typename Weight>
+    std::shared_ptr<const CsrGraph<Weight>> getCsrGraph(int id) const {
+        auto snap = snapshot(id);
+        return {snap, &snap->csr<Weight>()};
+    }
+
+    template<typename Weight>
+    std::shared_ptr<const CsrGraph<Weight>> getReverseCsrGraph(int id) const {
+        auto snap = snapshot(id);
+        return {snap, &snap->reverseCsr<Weight>()};
+    }
+
+    std::uint64_t graphVersion(int id) const {
+        auto slot = findSlot(id);
+        std::lock_guard writer(slot->writeMutex);
+        return slot->version;
+    }
+
+    // Keeps the index only if it was built from the current version; it counts against the budget.
+    template<typename Weight>
+    void setContractionHierarchy(int id, std::shared_ptr<const ContractionHierarchy<Weight>> index) {
+        auto slot = findSlot(id);
+        {
+            std::lock_guard writer(slot->writeMutex);
+            if (slot->removed || !slot->current.load() || index->graphVersion() != slot->version) {
+                return;
+            }
+            dropIndex(*slot);
+            slot->indexBytes = index->memoryBytes();
+            residentTotal += slot->indexBytes;
+            slot->contractionHierarchy.store(std::move(index));
+        }
+        enforceBudget(slot.get());
+    }
+
+    // Contraction hierarchy of the graph, or nullptr if none was built, it is stale
+    // or the graph was spilled since.
+    template<typename Weight>
+    std::shared_ptr<const ContractionHierarchy<Weight>> getContractionHierarchy(int id) const {
+        auto slot = findSlot(id);
+        auto index = std::static_pointer_cast<const ContractionHierarchy<Weight>>(slot->contractionHierarchy.load());
+        auto current = slot->current.load();
+        if (!index || !current || index->graphVersion() != current->version()) {
+            return nullptr;
+        }
+        return index;
+    }
+
+    // ---------- Memory accounting ----------
+
+    std::size_t memoryBudget() const { return budgetBytes.load(); }
+
+    // Applies a new budget right away, spilling graphs if needed.
+    void setMemoryBudget(std::size_t bytes) {
+        budgetBytes.store(bytes);
+        enforceBudget(nullptr);
+    }
+
+    // Approximate bytes of the resident graphs and indexes.
+    std::size_t residentBytes() const { return residentTotal.load(); }
+
+    // Approximate bytes graph id takes when resident, index included.
+    std::size_t graphBytes(int id) const {
+        auto slot = findSlot(id);
+        std::lock_guard writer(slot->writeMutex);
+        return slot->graphBytes + slot->indexBytes;
+    }
+
+    bool isResident(int id) const {
+        return findSlot(id)->current.load() != nullptr;
+    }
+
+    const std::filesystem::path& spillDirectory() const { return spillDir; }
+
+    // ---------- Persistence ----------
+
+    /**
+     * @brief Writes every stored graph to directory/graph-<id>.gcsr and removes
+     * graph files of ids no longer stored. Returns how many graphs were written.
+     *
+     * Each file is replaced atomically; a graph mapped from the same file is
+     * left as is, since mapped graphs are immutable.
+     */
+    std::size_t saveAll(const std::filesystem::path& directory) const {
+        std::filesystem::create_directories(directory);
+        std::set<int> saved;
+        for (int id : ids()) {
+            SnapshotPtr snap;
+            try {
+                snap = snapshot(id);
+            } catch (const std::runtime_error&) {
+                continue; // removed meanwhile
+            }
+            snap->codec_->persist(*snap, graphFilePath(directory, id));
+            saved.insert(id);
+        }
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            auto id = graphFileId(entry.path());
+            if (id && !saved.count(*id)) {
+                std::filesystem::remove(entry.path());
+            }
+        }
+        return saved.size();
+    }
+
+    /**
+     * @brief Maps the graph files of directory written by saveAll(), keeping
+     * their ids and versions. Ids already stored are left untouched. Returns
+     * how many graphs were loaded.
+     *
+     * A file that cannot be mapped (truncated, corrupt, another weight type)
+     * does not stop the others: it is reported on stderr and renamed to
+     * graph-<id>.gcsr.bad, so saveAll() does not delete it and it is not
+     * retried on the next start.
+     */
+    template<typename Weight>
+    std::size_t loadAll(const std::filesystem::path& directory) {
+        if (!std::filesystem::is_directory(directory)) {
+            return 0;
+        }
+        std::size_t loaded = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            auto id = graphFileId(entry.path());
+            if (!id || contains(*id)) {
+                continue;
+            }
+            std::shared_ptr<Snapshot> snap;
+            try {
+                GraphFile::MappedGraph<Weight> mapped(entry.path());
+                const std::uint64_t version = mapped.graphVersion();
+                snap = mapped.kind() == GraphSpill::GraphKind::AdjacencyMatrix
+                           ? makeSnapshot(GraphFile::toMatrix(mapped))
+                           : makeSnapshot(std::move(mapped));
+                snap->version_ = version;
+            } catch (const std::exception& e) {
+                std::filesystem::path aside = entry.path();
+                aside += ".bad";
+                std::error_code ec;
+                std::filesystem::rename(entry.path(), aside, ec);
+                std::cerr << "Skipping graph file: " << e.what() << '\n';
+                continue;
+            }
+            insert(*id, std::move(snap));
+
+            int next = nextId.load();
+            while (next <= *id && !nextId.compare_exchange_weak(next, *id + 1)) {
+            }
+            ++loaded;
+        }
+        return loaded;
+    }
+
+private:
+    struct Slot {
+        int id = 0;
+        std::atomic<SnapshotPtr> current; // nullptr while spilled to disk
+        std::atomic<std::uint64_t> lastUse{0}; // LRU clock reading of the last access
+        // Serializes writers, spills and reloads of this id; guards the fields below.
+        std::mutex writeMutex;
+        std::uint64_t version = 0;
+        std::size_t graphBytes = 0;
+        std::size_t indexBytes = 0;
+        bool removed = false;
+        VertexOrder order = VertexOrder::Original; // set once, before the slot is shared
+        std::optional<std::uint64_t> spilledVersion; // version in the spill file, if any
+        const Codec* codec = nullptr; // of the current graph, also while spilled
+        // Derived index; it records the version it was built from and is
+        // ignored once the slot has moved on.
+        std::atomic<std::shared_ptr<const void>> contractionHierarchy;
+    };
+
+    std::atomic<int> nextId{0};
+    mutable std::shared_mutex mutex;
+    std::unordered_map<int, std::shared_ptr<Slot>> graphs;
+
+    std::atomic<std::size_t> budgetBytes;
+    mutable std::atomic<std::size_t> residentTotal{0};
+    mutable std::atomic<std::uint64_t> useClock{0};
+    // One eviction pass at a time; taken before any slot's writeMutex.
+    mutable std::mutex evictionMutex;
+    std::filesystem::path spillDir;
+
+    std::shared_ptr<Slot> findSlot(int id) const {
+        std::shared_lock lock(mutex);
         auto it = graphs.find(id);
         if (it == graphs.end()) {
             throw std::runtime_error("Graph not found");
         }
-        return *std::static_pointer_cast<GraphT>(it->second);
+        return it->second;
+    }
+
+    void insert(int id, std::shared_ptr<Snapshot> snap) {
+        auto slot = std::make_shared<Slot>();
+        slot->id = id;
+        slot->version = snap->version();
+        slot->order = snap->vertexOrder();
+        slot->graphBytes = snap->memoryBytes();
+        slot->codec = snap->codec_;
+        slot->current.store(std::move(snap));
+        touch(*slot);
+        residentTotal += slot->graphBytes;
+        {
+            std::unique_lock lock(mutex);
+            graphs.emplace(id, slot);
+        }
+        enforceBudget(slot.get());
+    }
+
+    static std::filesystem::path graphFilePath(const std::filesystem::path& directory, int id) {
+        return directory / ("graph-" + std::to_string(id) + ".gcsr");
+    }
+
+    // Id encoded in a graph file name, if it is one.
+    static std::optional<int> graphFileId(const std::filesystem::path& path) {
+        const std::string name = path.filename().string();
+        if (path.extension() != ".gcsr" || name.rfind("graph-", 0) != 0) {
+            return std::nullopt;
+        }
+        try {
+            std::size_t used = 0;
+            const std::string digits = path.stem().string().substr(6);
+            int id = std::stoi(digits, &used);
+            return used == digits.size() ? std::optional<int>(id) : std::nullopt;
+        } catch (const std::logic_error&) {
+            return std::nullopt;
+        }
+    }
+
+    void touch(Slot& slot) const {
+        slot.lastUse.store(useClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::filesystem::path spillPath(int id) const {
+        return spillDir / ("graph-" + std::to_string(id) + ".bin");
+    }
+
+    // Requires slot.writeMutex.
+    void dropIndex(Slot& slot) const {
+        slot.contractionHierarchy.store(nullptr);
+        residentTotal -= slot.indexBytes;
+        slot.indexBytes = 0;
+    }
+
+    SnapshotPtr reload(Slot& slot) const {
+        SnapshotPtr snap;
+        {
+            std::lock_guard writer(slot.writeMutex);
+            snap = slot.current.load();
+            if (!snap) {
+                if (slot.removed) {
+                    throw std::runtime_error("Graph not found");
+                }
+                auto loaded = slot.codec->reload(spillPath(slot.id), slot.order);
+                loaded->version_ = slot.version;
+                slot.graphBytes = loaded->memoryBytes();
+                residentTotal += slot.graphBytes;
+                snap = std::move(loaded);
+                slot.current.store(snap);
+            }
+        }
+        enforceBudget(&slot);
+        return snap;
+    }
+
+    // Spills least recently used graphs other than keep until the resident total fits the budget.
+    void enforceBudget(const Slot* keep) const {
+        const std::size_t budget = budgetBytes.load();
+        if (budget == 0 || residentTotal.load() <= budget) {
+            return;
+        }
+
+        std::lock_guard eviction(evictionMutex);
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<Slot>>> candidates;
+        {
+            std::shared_lock lock(mutex);
+            candidates.reserve(graphs.size());
+            for (const auto& [id, slot] : graphs) {
+                if (slot.get() != keep) {
+                    candidates.emplace_back(slot->lastUse.load(std::memory_order_relaxed), slot);
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (const auto& [_, slot] : candidates) {
+            if (residentTotal.load() <= budget) {
+                break;
+            }
+            try {
+                spill(*slot);
+            } catch (const std::exception&) {
+                // The graph stays resident; a failed spill (e.g. disk full)
+                // must not fail the request that went over the budget.
+                break;
+            }
+        }
+    }
+
+    void spill(Slot& slot) const {
+        std::lock_guard writer(slot.writeMutex);
+        auto snap = slot.current.load();
+        if (!snap || slot.removed) {
+            return;
+        }
+        // A graph reloaded and not modified since is still on disk.
+        if (slot.spilledVersion != slot.version) {
+            std::filesystem::create_directories(spillDir);
+            const auto path = spillPath(slot.id);
+            auto temporary = path;
+            temporary += ".tmp";
+            slot.codec->spill(*snap, temporary);
+            std::filesystem::rename(temporary, path);
+            slot.spilledVersion = slot.version;
+        }
+        slot.current.store(nullptr);
+        residentTotal -= slot.graphBytes;
+        dropIndex(slot);
+    }
+
+    struct Codec {
+        void (*spill)(const Snapshot&, const std::filesystem::path&);
+        std::shared_ptr<Snapshot> (*reload)(const std::filesystem::path&, VertexOrder);
+        void (*persist)(const Snapshot&, const std::filesystem::path&);
+    };
+
+    // Mutable graphs spill in the compact GraphSpill format and reload as the same type.
+    template<typename Graph>
+    static void spillGraph(const Snapshot& snap, const std::filesystem::path& path) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot create graph spill file");
+        }
+        GraphSpill::write(out, snap.graph<Graph>());
+    }
+
+    template<typename Graph>
+    static std::shared_ptr<Snapshot> reloadGraph(const std::filesystem::path& path, VertexOrder order) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Graph spill file is missing");
+        }
+        return makeSnapshot(GraphSpill::read<Graph>(in), order);
+    }
+
+    template<typename Graph>
+    static void persistGraph(const Snapshot& snap, const std::filesystem::path& path) {
+        using Weight = typename Graph::weight_type;
+        if constexpr (std::is_same_v<Graph, AdjacencyListGraph<Weight>>) {
+            const auto& csr = snap.csr<Weight>();
+            GraphFile::write(path, snap.graph<Graph>(), csr, csr.isDirected() ? &snap.reverseCsr<Weight>() : nullptr,
+                             snap.version(), snap.vertexOrder());
+        } else {
+            GraphFile::write(path, snap.graph<Graph>(), snap.version());
+        }
+    }
+
+    // Mapped graphs are already in graph file form: spilling copies the file and
+    // reloading maps the copy, vertex order included.
+    template<typename Weight>
+    static void spillMapped(const Snapshot& snap, const std::filesystem::path& path) {
+        GraphFile::write(path, snap.graph<GraphFile::MappedGraph<Weight>>());
+    }
+
+    template<typename Weight>
+    static std::shared_ptr<Snapshot> reloadMapped(const std::filesystem::path& path, VertexOrder) {
+        return makeSnapshot(GraphFile::MappedGraph<Weight>(path));
+    }
+
+    template<typename Weight>
+    static void persistMapped(const Snapshot& snap, const std::filesystem::path& path) {
+        const auto& mapped = snap.graph<GraphFile::MappedGraph<Weight>>();
+        std::error_code ec;
+        if (!std::filesystem::equivalent(mapped.source(), path, ec)) {
+            GraphFile::write(path, mapped);
+        }
+    }
+
+    template<typename Graph>
+    struct CodecFor {
+        static constexpr Codec value{&spillGraph<Graph>, &reloadGraph<Graph>, &persistGraph<Graph>};
+    };
+
+    template<typename Weight>
+    struct CodecFor<GraphFile::MappedGraph<Weight>> {
+        static constexpr Codec value{&spillMapped<Weight>, &reloadMapped<Weight>, &persistMapped<Weight>};
+    };
+
+    template<typename GraphT>
+    static std::shared_ptr<Snapshot> makeSnapshot(GraphT&& graph, VertexOrder order = VertexOrder::Original) {
+        using Graph = std::remove_cvref_t<GraphT>;
+        auto snap = std::make_shared<Snapshot>();
+        auto stored = std::make_shared<const Graph>(std::forward<GraphT>(graph));
+        snap->bytes_ = stored->memoryBytes();
+        snap->codec_ = &CodecFor<Graph>::value;
+        if constexpr (std::is_same_v<Graph, GraphFile::MappedGraph<typename Graph::weight_type>>) {
+            using Csr = CsrGraph<typename Graph::weight_type>;
+            // Views into the mapping; they share ownership of the mapped graph.
+            snap->csr_ = std::shared_ptr<const void>(stored, &stored->csr());
+            if (stored->reverse()) {
+                snap->reverseCsr_ = std::shared_ptr<const void>(stored, stored->reverse());
+            } else if (stored->isDirected()) {
+                auto reverse = std::make_shared<const Csr>(stored->csr().transposed());
+                snap->bytes_ += reverse->memoryBytes();
+                snap->reverseCsr_ = std::move(reverse);
+            }
+            snap->csrType_ = typeid(Csr);
+            snap->order_ = stored->vertexOrder();
+        } else if constexpr (std::is_same_v<Graph, AdjacencyListGraph<typename Graph::weight_type>>) {
+            using Csr = CsrGraph<typename Graph::weight_type>;
+            auto csr = std::make_shared<const Csr>(Algorithms::Reorder(Csr(*stored), order));
+            snap->bytes_ += csr->memoryBytes() + csr->vertexIndex().memoryBytes();
+            if (csr->isDirected()) {
+                auto reverse = std::make_shared<const Csr>(csr->transposed());
+                snap->bytes_ += reverse->memoryBytes();
+                snap->reverseCsr_ = std::move(reverse);
+            }
+            snap->csr_ = std::move(csr);
+            snap->csrType_ = typeid(Csr);
+            snap->order_ = order;
+        }
+        snap->graph_ = std::move(stored);
+        snap->type_ = typeid(Graph);
+        return snap;
     }
 };
@@ -0,0 +1,189 @@
+#pragma once
+#include "graph_core/GraphStorage.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Binary (de)serialization of stored graphs for the repository's spill files.
+ *
+ * A file starts with a fixed header (magic, format version, graph kind, weight
+ * type tag, directed flag) so a reload checks it gets back exactly the type it
+ * spilled. The payload is raw values in host byte order: spill files are a
+ * private cache of one process, not an exchange format.
+ */
+namespace GraphSpill {
+
+enum class GraphKind : std::uint8_t {
+    AdjacencyList = 1,
+    AdjacencyMatrix = 2,
+};
+
+inline constexpr char magic[4] = {'G', 'S', 'P', 'L'};
+inline constexpr std::uint32_t formatVersion = 1;
+
+// Encodes size, signedness and integral/floating-point of Weight in one byte.
+template<typename Weight>
+constexpr std::uint8_t weightTag() {
+    static_assert(std::is_arithmetic_v<Weight> && sizeof(Weight) <= 16);
+    return static_cast<std::uint8_t>((std::is_floating_point_v<Weight> ? 0x80 : 0)
+                                     | (std::is_signed_v<Weight> ? 0x40 : 0) | sizeof(Weight));
+}
+
+namespace detail {
+
+template<typename T>
+void put(std::ostream& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T get(std::istream& in) {
+    T value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::runtime_error("Truncated graph spill file");
+    }
+    return value;
+}
+
+inline void putString(std::ostream& out, const std::string& s) {
+    put<std::uint64_t>(out, s.size());
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+inline std::string getString(std::istream& in) {
+    std::string s(get<std::uint64_t>(in), '\0');
+    if (!in.read(s.data(), static_cast<std::streamsize>(s.size()))) {
+        throw std::runtime_error("Truncated graph spill file");
+    }
+    return s;
+}
+
+inline void putHeader(std::ostream& out, GraphKind kind, std::uint8_t weight, bool directed) {
+    out.write(magic, sizeof(magic));
+    put(out, formatVersion);
+    put(out, kind);
+    put(out, weight);
+    put<std::uint8_t>(out, directed ? 1 : 0);
+}
+
+// Checks the header against the expected type and returns the directed flag.
+inline bool getHeader(std::istream& in, GraphKind kind, std::uint8_t weight) {
+    char fileMagic[sizeof(magic)];
+    if (!in.read(fileMagic, sizeof(fileMagic)) || !std::equal(fileMagic, fileMagic + sizeof(magic), magic)) {
+        throw std::runtime_error("Not a graph spill file");
+    }
+    if (get<std::uint32_t>(in) != formatVersion) {
+        throw std::runtime_error("Unsupported graph spill format version");
+    }
+    if (get<GraphKind>(in) != kind || get<std::uint8_t>(in) != weight) {
+        throw std::runtime_error("Graph spill file has a different type");
+    }
+    return get<std::uint8_t>(in) != 0;
+}
+
+} // namespace detail
+
+template<typename Weight>
+void write(std::ostream& out, const AdjacencyListGraph<Weight>& graph) {
+    detail::putHeader(out, GraphKind::AdjacencyList, weightTag<Weight>(), graph.isDirected());
+
+    // Labels first: reading them back with addNode also recreates isolated nodes.
+    const auto& labels = graph.getNodeLabels();
+    detail::put<std::uint64_t>(out, labels.size());
+    for (const auto& [id, label] : labels) {
+        detail::put<std::int32_t>(out, id);
+        detail::putString(out, label);
+    }
+
+    // Adjacency lists as stored, so undirected edges are written in both directions.
+    const auto& adj = graph.getAdjList();
+    detail::put<std::uint64_t>(out, adj.size());
+    for (const auto& [id, edges] : adj) {
+        detail::put<std::int32_t>(out, id);
+        detail::put<std::uint64_t>(out, edges.size());
+        for (const auto& [to, weight] : edges) {
+            detail::put<std::int32_t>(out, to);
+            detail::put<Weight>(out, weight);
+        }
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write graph spill file");
+    }
+}
+
+template<typename Weight>
+void write(std::ostream& out, const AdjacencyMatrixGraph<Weight>& graph) {
+    detail::putHeader(out, GraphKind::AdjacencyMatrix, weightTag<Weight>(), graph.isDirected());
+    detail::put<std::uint64_t>(out, graph.size());
+    for (const auto& label : graph.getNodeLabels()) {
+        detail::putString(out, label);
+    }
+    // Only present edges, as (to, weight) pairs per row.
+    for (size_t i = 0; i < graph.size(); ++i) {
+        detail::put<std::uint64_t>(out, graph.degree(i));
+        graph.forEachNeighbor(i, [&](size_t j, Weight w) {
+            detail::put<std::uint64_t>(out, j);
+            detail::put<Weight>(out, w);
+        });
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write graph spill file");
+    }
+}
+
+template<typename GraphT>
+    requires std::is_same_v<GraphT, AdjacencyListGraph<typename GraphT::weight_type>>
+GraphT read(std::istream& in) {
+    using Weight = typename GraphT::weight_type;
+    GraphT graph(detail::getHeader(in, GraphKind::AdjacencyList, weightTag<Weight>()));
+
+    const auto labelCount = detail::get<std::uint64_t>(in);
+    graph.reserve(labelCount);
+    for (std::uint64_t k = 0; k < labelCount; ++k) {
+        const int id = detail::get<std::int32_t>(in);
+        graph.addNode(id, detail::getString(in));
+    }
+
+    const auto nodeCount = detail::get<std::uint64_t>(in);
+    for (std::uint64_t k = 0; k < nodeCount; ++k) {
+        const int from = detail::get<std::int32_t>(in);
+        const auto degree = detail::get<std::uint64_t>(in);
+        for (std::uint64_t e = 0; e < degree; ++e) {
+            const int to = detail::get<std::int32_t>(in);
+            graph.addArc(from, to, detail::get<Weight>(in));
+        }
+    }
+    return graph;
+}
+
+template<typename GraphT>
+    requires std::is_same_v<GraphT, AdjacencyMatrixGraph<typename GraphT::weight_type>>
+GraphT read(std::istream& in) {
+    using Weight = typename GraphT::weight_type;
+    const bool directed = detail::getHeader(in, GraphKind::AdjacencyMatrix, weightTag<Weight>());
+    const auto n = detail::get<std::uint64_t>(in);
+    GraphT graph(n, directed);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        graph.addNode(static_cast<int>(i), detail::getString(in));
+    }
+    // Rows already hold both directions of undirected edges; re-adding one
+    // direction at a time mirrors it onto an entry that is rewritten anyway.
+    for (std::uint64_t i = 0; i < n; ++i) {
+        const auto degree = detail::get<std::uint64_t>(in);
+        for (std::uint64_t e = 0; e < degree; ++e) {
+            const auto j = detail::get<std::uint64_t>(in);
+            graph.addEdge(static_cast<int>(i), static_cast<int>(j), detail::get<Weight>(in));
+        }
+    }
+    return graph;
+}
+
+} // namespace GraphSpill
@@ -0,0 +1,196 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Thread-safe LRU cache of serialized algorithm results.
+ *
+ * Entries are keyed on (graph id, graph version, algorithm, source) and hold
+ * the response bytes, so a hit is a lookup and a copy. Only the latest version
+ * seen for a graph is kept: looking up or storing a newer version drops every
+ * entry of the older one, and invalidate() drops a graph's entries outright
+ * (e.g. when it is removed or mutated).
+ *
+ * The cache holds at most capacityBytes() bytes (keys, values and bookkeeping);
+ * the least recently used entries are evicted to make room. A result larger
+ * than an eighth of the capacity is not stored, so one huge response cannot
+ * flush everything else. Capacity 0 disables the cache.
+ */
+class ResultCache {
+public:
+    using Value = std::shared_ptr<const std::string>;
+
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+    };
+
+    explicit ResultCache(std::size_t capacityBytes = 0) : capacity(capacityBytes) {}
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // Cached bytes for the key, or nullptr.
+    Value find(int graphId, std::uint64_t version, std::string_view algorithm, int source) {
+        std::lock_guard lock(mutex);
+        auto graph = currentGraph(graphId, version);
+        if (graph->second.version == version) {
+            auto it = graph->second.entries.find(entryKey(algorithm, source));
+            if (it != graph->second.entries.end()) {
+                lru.splice(lru.begin(), lru, it->second);
+                ++counters.hits;
+                return it->second->value;
+            }
+        }
+        ++counters.misses;
+        return nullptr;
+    }
+
+    // Stores bytes under the key (replacing any previous entry) and returns them shared.
+    Value store(int graphId, std::uint64_t version, std::string_view algorithm, int source, std::string bytes) {
+        auto value = std::make_shared<const std::string>(std::move(bytes));
+        std::string key = entryKey(algorithm, source);
+        const std::size_t cost = entryBytes(key, *value);
+
+        std::lock_guard lock(mutex);
+        if (cost > capacity / 8) {
+            return value;
+        }
+        auto graph = currentGraph(graphId, version);
+        if (graph->second.version > version) {
+            return value; // a newer version has been seen already
+        }
+
+        auto& entries = graph->second.entries;
+        if (auto old = entries.find(key); old != entries.end()) {
+            used -= old->second->bytes;
+            old->second->value = value;
+            old->second->bytes = cost;
+            lru.splice(lru.begin(), lru, old->second);
+        } else {
+            lru.push_front(Entry{graphId, key, value, cost});
+            entries.emplace(std::move(key), lru.begin());
+        }
+        used += cost;
+        evictTo(capacity);
+        return value;
+    }
+
+    // Drops every entry of graphId.
+    void invalidate(int graphId) {
+        std::lock_guard lock(mutex);
+        dropGraph(graphId);
+    }
+
+    void clear() {
+        std::lock_guard lock(mutex);
+        lru.clear();
+        graphs.clear();
+        used = 0;
+    }
+
+    void setCapacity(std::size_t bytes) {
+        std::lock_guard lock(mutex);
+        capacity = bytes;
+        evictTo(capacity);
+    }
+
+    std::size_t capacityBytes() const {
+        std::lock_guard lock(mutex);
+        return capacity;
+    }
+
+    Stats stats() const {
+        std::lock_guard lock(mutex);
+        Stats s = counters;
+        s.entries = lru.size();
+        s.bytes = used;
+        return s;
+    }
+
+private:
+    struct Entry {
+        int graphId;
+        std::string key;
+        Value value;
+        std::size_t bytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    struct GraphEntries {
+        std::uint64_t version;
+        std::unordered_map<std::string, EntryList::iterator> entries;
+    };
+    using GraphMap = std::unordered_map<int, GraphEntries>;
+
+    static std::string entryKey(std::string_view algorithm, int source) {
+        std::string key(algorithm);
+        key += '\0';
+        key += std::to_string(source);
+        return key;
+    }
+
+    // Key and value bytes plus the list node, hash node and shared_ptr control block.
+    static std::size_t entryBytes(const std::string& key, const std::string& value) {
+        return sizeof(Entry) + 2 * key.capacity() + value.capacity() + 128;
+    }
+
+    // Table of graphId, created or emptied so that it holds the newest version seen.
+    GraphMap::iterator currentGraph(int graphId, std::uint64_t version) {
+        auto it = graphs.try_emplace(graphId, GraphEntries{version, {}}).first;
+        if (it->second.version < version) {
+            dropEntries(it->second);
+            it->second.version = version;
+        }
+        return it;
+    }
+
+    void dropEntries(GraphEntries& graph) {
+        for (auto& [key, entry] : graph.entries) {
+            used -= entry->bytes;
+            lru.erase(entry);
+        }
+        graph.entries.clear();
+    }
+
+    void dropGraph(int graphId) {
+        auto it = graphs.find(graphId);
+        if (it != graphs.end()) {
+            dropEntries(it->second);
+            graphs.erase(it);
+        }
+    }
+
+    // Removes one entry from the list and its graph's table (the table itself stays, to
+    // remember the version).
+    void erase(EntryList::iterator entry) {
+        graphs.find(entry->graphId)->second.entries.erase(entry->key);
+        used -= entry->bytes;
+        lru.erase(entry);
+    }
+
+    void evictTo(std::size_t bytes) {
+        while (used > bytes && !lru.empty()) {
+            erase(std::prev(lru.end()));
+            ++counters.evictions;
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::size_t capacity;
+    std::size_t used = 0;
+    EntryList lru; // most recently used first
+    GraphMap graphs;
+    Stats counters;
+};
@@ -0,0 +1,255 @@
+#pragma once
+#include "graph_core/Trace.hpp"
+#include "jobs/WorkStealingPool.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Runs submitted work as asynchronous jobs on a WorkStealingPool.
+ *
+ * A job is a function that produces an HTTP-like outcome (status code and
+ * body) and gets a cancellation flag to poll, typically through
+ * CancellableTrace. Jobs belong to a graph, and at most perGraphLimit() jobs
+ * of the same graph run at once; the rest wait in submission order without
+ * occupying a worker, so one busy graph cannot take the whole pool.
+ *
+ * cancel() is cooperative: a waiting job is cancelled on the spot, a running
+ * one when its work next checks the flag (the work throws OperationCancelled
+ * or returns). Finished jobs are kept, results included, while they are
+ * among the last retainedJobs() to finish and the result bodies of those
+ * kept add up to at most retainedBytes(); past either limit the oldest are
+ * dropped first. The newest finished job is always kept, whatever its size.
+ */
+class JobManager {
+public:
+    enum class State { Queued, Running, Done, Failed, Cancelled };
+
+    struct Outcome {
+        int status = 200;
+        std::string body;
+    };
+
+    using Work = std::function<Outcome(const std::atomic<bool>& cancelled)>;
+    using Clock = std::chrono::steady_clock;
+
+    // Copy of a job's state; result is set once the job is Done or Failed.
+    struct Info {
+        std::uint64_t id = 0;
+        int graphId = 0;
+        std::string label;
+        State state = State::Queued;
+        Clock::time_point submitted, started, finished;
+        int status = 0;
+        std::shared_ptr<const std::string> result;
+    };
+
+    // threads == 0 uses the hardware concurrency.
+    explicit JobManager(unsigned threads = 0, unsigned perGraphLimit = 2, std::size_t retainedJobs = 1024,
+                        std::size_t retainedBytes = std::size_t{256} << 20)
+        : perGraph(std::max(1u, perGraphLimit)), retained(retainedJobs), retainedBytesLimit(retainedBytes),
+          pool(threads) {}
+
+    JobManager(const JobManager&) = delete;
+    JobManager& operator=(const JobManager&) = delete;
+
+    // Cancels everything, then waits for the running jobs to stop (pool destructor).
+    ~JobManager() {
+        std::lock_guard lock(mutex);
+        stopping = true;
+        for (auto& [id, job] : jobs)
+            job->cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    std::uint64_t submit(int graphId, std::string label, Work work) {
+        auto job = std::make_shared<Job>();
+        job->graphId = graphId;
+        job->label = std::move(label);
+        job->work = std::move(work);
+        job->submitted = Clock::now();
+
+        std::lock_guard lock(mutex);
+        job->id = nextId++;
+        jobs.emplace(job->id, job);
+        GraphQueue& queue = graphs[graphId];
+        if (queue.running < perGraph) {
+            ++queue.running;
+            dispatch(job);
+        } else {
+            queue.waiting.push_back(job);
+        }
+        return job->id;
+    }
+
+    std::optional<Info> find(std::uint64_t id) const {
+        std::lock_guard lock(mutex);
+        auto it = jobs.find(id);
+        if (it == jobs.end())
+            return std::nullopt;
+        const Job& job = *it->second;
+        return Info{job.id, job.graphId, job.label, job.state, job.submitted, job.started, job.finished,
+                    job.status, job.result};
+    }
+
+    // Requests cancellation; false if the job does not exist.
+    bool cancel(std::uint64_t id) {
+        std::lock_guard lock(mutex);
+        auto it = jobs.find(id);
+        if (it == jobs.end())
+            return false;
+        Job& job = *it->second;
+        job.cancelled.store(true, std::memory_order_relaxed);
+        if (job.state == State::Queued)
+            finish(job, State::Cancelled); // still counted in its graph queue until popped
+        return true;
+    }
+
+    // Jobs known to the manager in each state, indexed by State.
+    std::array<std::size_t, 5> stateCounts() const {
+        std::array<std::size_t, 5> counts{};
+        std::lock_guard lock(mutex);
+        for (const auto& [id, job] : jobs)
+            ++counts[static_cast<std::size_t>(job->state)];
+        return counts;
+    }
+
+    unsigned threads() const { return pool.size(); }
+    unsigned perGraphLimit() const { return perGraph; }
+    std::size_t retainedJobs() const { return retained; }
+    std::size_t retainedBytes() const { return retainedBytesLimit; }
+
+    // Bytes of result bodies currently held by finished jobs.
+    std::size_t resultBytes() const {
+        std::lock_guard lock(mutex);
+        return finishedBytes;
+    }
+
+    static const char* stateName(State state) {
+        switch (state) {
+            case State::Queued: return "queued";
+            case State::Running: return "running";
+            case State::Done: return "done";
+            case State::Failed: return "failed";
+            default: return "cancelled";
+        }
+    }
+
+private:
+    struct Job {
+        std::uint64_t id = 0;
+        int graphId = 0;
+        std::string label;
+        Work work;
+        std::atomic<bool> cancelled{false};
+        State state = State::Queued; // the fields below are guarded by the manager mutex
+        Clock::time_point submitted, started, finished;
+        int status = 0;
+        std::shared_ptr<const std::string> result;
+    };
+
+    struct Finished {
+        std::uint64_t id;
+        std::size_t bytes; // result body size
+    };
+
+    struct GraphQueue {
+        unsigned running = 0; // jobs dispatched to the pool and not yet finished
+        std::deque<std::shared_ptr<Job>> waiting;
+    };
+
+    // Requires mutex.
+    void dispatch(std::shared_ptr<Job> job) {
+        pool.submit([this, job = std::move(job)] { run(*job); });
+    }
+
+    void run(Job& job) {
+        {
+            std::lock_guard lock(mutex);
+            if (job.state == State::Queued && job.cancelled.load(std::memory_order_relaxed))
+                finish(job, State::Cancelled); // cancelled by the destructor
+            if (job.state != State::Queued) {
+                release(job.graphId);
+                return;
+            }
+            job.state = State::Running;
+            job.started = Clock::now();
+        }
+
+        State state;
+        Outcome outcome;
+        try {
+            outcome = job.work(job.cancelled);
+            state = outcome.status == 200 ? State::Done : State::Failed;
+        } catch (const OperationCancelled&) {
+            state = State::Cancelled;
+        } catch (const std::exception& e) {
+            state = State::Failed;
+            outcome = {500, e.what()};
+        }
+
+        std::lock_guard lock(mutex);
+        if (state != State::Cancelled) {
+            job.status = outcome.status;
+            job.result = std::make_shared<const std::string>(std::move(outcome.body));
+        }
+        job.work = nullptr;
+        finish(job, state);
+        release(job.graphId);
+    }
+
+    // Requires mutex. Frees a running slot of the graph and starts its next waiting job.
+    void release(int graphId) {
+        auto it = graphs.find(graphId);
+        GraphQueue& queue = it->second;
+        --queue.running;
+        while (!stopping && !queue.waiting.empty()) {
+            auto next = std::move(queue.waiting.front());
+            queue.waiting.pop_front();
+            if (next->state == State::Queued) {
+                ++queue.running;
+                dispatch(std::move(next));
+                return;
+            }
+        }
+        if (queue.running == 0 && queue.waiting.empty())
+            graphs.erase(it);
+    }
+
+    // Requires mutex. Oldest finished jobs go first when over either retention limit.
+    void finish(Job& job, State state) {
+        job.state = state;
+        job.finished = Clock::now();
+        const std::size_t bytes = job.result ? job.result->size() : 0;
+        finishedOrder.push_back({job.id, bytes});
+        finishedBytes += bytes;
+        while (finishedOrder.size() > 1
+               && (finishedOrder.size() > retained || finishedBytes > retainedBytesLimit)) {
+            jobs.erase(finishedOrder.front().id);
+            finishedBytes -= finishedOrder.front().bytes;
+            finishedOrder.pop_front();
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::uint64_t nextId = 1;
+    unsigned perGraph;
+    std::size_t retained;
+    std::size_t retainedBytesLimit;
+    std::size_t finishedBytes = 0;
+    bool stopping = false;
+    std::unordered_map<std::uint64_t, std::shared_ptr<Job>> jobs;
+    std::unordered_map<int, GraphQueue> graphs;
+    std::deque<Finished> finishedOrder;
+    WorkStealingPool pool; // last: destroyed (and joined) first
+};
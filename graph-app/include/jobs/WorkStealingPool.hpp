@@ -0,0 +1,145 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Fixed-size thread pool where idle workers steal queued tasks.
+ *
+ * Every worker owns a deque. Tasks submitted from outside the pool are dealt
+ * round-robin across the deques; a task submitted from a worker goes to that
+ * worker's own deque. A worker pops the newest task of its own deque (LIFO,
+ * cache-warm) and, when that is empty, steals the oldest task of another
+ * deque (FIFO), so a long task never holds up the tasks queued behind it
+ * while some other worker is idle. Each deque has its own mutex: tasks here
+ * are coarse (whole algorithm runs), so contention is negligible.
+ *
+ * The destructor runs every task already submitted, then joins the workers.
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    // threads == 0 uses the hardware concurrency.
+    explicit WorkStealingPool(unsigned threads = 0) {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i < threads; ++i)
+            queues_.push_back(std::make_unique<Queue>());
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+            workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard lock(sleepMutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        workers_.clear(); // joins
+    }
+
+    // task must not throw.
+    void submit(Task task) {
+        const std::size_t q = current_.pool == this
+            ? current_.index
+            : next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        // counted before it is queued, so pending_ never drops below the tasks taken
+        {
+            std::lock_guard lock(sleepMutex_);
+            ++pending_;
+        }
+        {
+            std::lock_guard lock(queues_[q]->mutex);
+            queues_[q]->tasks.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    unsigned size() const { return static_cast<unsigned>(queues_.size()); }
+
+    // Tasks submitted but not yet started.
+    std::size_t pending() const {
+        std::lock_guard lock(sleepMutex_);
+        return pending_;
+    }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Pool and deque of the calling thread, if it is a worker (zero-initialized otherwise).
+    struct WorkerSlot {
+        const WorkStealingPool* pool;
+        std::size_t index;
+    };
+    static inline thread_local WorkerSlot current_;
+
+    void workerLoop(std::size_t self) {
+        current_ = {this, self};
+        Task task;
+        for (;;) {
+            {
+                std::unique_lock lock(sleepMutex_);
+                wake_.wait(lock, [this] { return pending_ > 0 || stopping_; });
+                if (pending_ == 0)
+                    return; // stopping and nothing left
+            }
+            if (!take(self, task)) {
+                std::this_thread::yield(); // taken by another worker, or not queued yet
+                continue;
+            }
+            {
+                std::lock_guard lock(sleepMutex_);
+                --pending_;
+            }
+            task();
+            task = nullptr;
+        }
+    }
+
+    // Own deque from the back, then the others from the front.
+    bool take(std::size_t self, Task& task) {
+        {
+            Queue& own = *queues_[self];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (std::size_t k = 1; k < queues_.size(); ++k) {
+            Queue& victim = *queues_[(self + k) % queues_.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::atomic<std::size_t> next_{0};
+    mutable std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::size_t pending_ = 0; // tasks submitted and not yet taken; guarded by sleepMutex_
+    bool stopping_ = false;
+    std::vector<std::jthread> workers_; // last: joined before the queues go away
+};
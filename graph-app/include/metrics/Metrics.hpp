@@ -0,0 +1,312 @@
+#pragma once
+#include "graph_core/Trace.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace metrics_detail {
+    inline constexpr std::size_t shardCount = 16;
+
+    // Shard of the calling thread: threads are dealt round-robin on first use, so with
+    // up to shardCount threads (Crow's pool, the job workers) none share a shard.
+    inline std::size_t shardIndex() {
+        static std::atomic<std::size_t> next{0};
+        thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % shardCount;
+        return index;
+    }
+}
+
+/**
+ * @brief Monotonic counter split into per-thread shards.
+ *
+ * add() is one relaxed atomic increment on a cache line that, in practice, only
+ * the calling thread writes; value() sums the shards.
+ */
+class ShardedCounter {
+public:
+    void add(std::uint64_t n = 1) {
+        shards[metrics_detail::shardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    std::uint64_t value() const {
+        std::uint64_t total = 0;
+        for (const Shard& shard : shards)
+            total += shard.value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+    std::array<Shard, metrics_detail::shardCount> shards;
+};
+
+/**
+ * @brief Latency histogram with fixed Prometheus-style buckets, split into per-thread shards.
+ *
+ * observe() finds the bucket with a short linear scan and does two relaxed
+ * atomic increments on the calling thread's shard; no lock is taken. A
+ * snapshot() taken while observations are in flight may be off by those few,
+ * which a scrape tolerates.
+ */
+class LatencyHistogram {
+public:
+    // Upper bounds in seconds; an implicit +Inf bucket follows.
+    static constexpr std::array<double, 14> bounds{0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+                                                   0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+
+    struct Snapshot {
+        std::array<std::uint64_t, bounds.size() + 1> buckets{}; // per bucket, not cumulative
+        std::uint64_t count = 0;
+        double sum = 0.0; // seconds
+    };
+
+    void observe(std::chrono::nanoseconds elapsed) {
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        std::size_t b = 0;
+        while (b < bounds.size() && seconds > bounds[b])
+            ++b;
+        Shard& shard = shards[metrics_detail::shardIndex()];
+        shard.buckets[b].fetch_add(1, std::memory_order_relaxed);
+        shard.sumNanos.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot s;
+        std::uint64_t nanos = 0;
+        for (const Shard& shard : shards) {
+            for (std::size_t b = 0; b < s.buckets.size(); ++b)
+                s.buckets[b] += shard.buckets[b].load(std::memory_order_relaxed);
+            nanos += shard.sumNanos.load(std::memory_order_relaxed);
+        }
+        for (std::uint64_t n : s.buckets)
+            s.count += n;
+        s.sum = static_cast<double>(nanos) / 1e9;
+        return s;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<std::uint64_t>, bounds.size() + 1> buckets{};
+        std::atomic<std::uint64_t> sumNanos{0};
+    };
+    std::array<Shard, metrics_detail::shardCount> shards;
+};
+
+/**
+ * @brief Appends samples in the Prometheus text exposition format (version 0.0.4).
+ */
+class PrometheusWriter {
+public:
+    explicit PrometheusWriter(std::string& target) : out(target) {}
+
+    using Labels = std::initializer_list<std::pair<std::string_view, std::string_view>>;
+
+    // HELP and TYPE lines; once per metric family, before its samples.
+    PrometheusWriter& family(std::string_view name, std::string_view type, std::string_view help) {
+        out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+        out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+        return *this;
+    }
+
+    PrometheusWriter& sample(std::string_view name, Labels labels, double value) {
+        out.append(name);
+        if (labels.size() > 0) {
+            out.push_back('{');
+            bool first = true;
+            for (const auto& [key, label] : labels) {
+                if (!first)
+                    out.push_back(',');
+                first = false;
+                out.append(key).append("=\"");
+                appendEscaped(label);
+                out.push_back('"');
+            }
+            out.push_back('}');
+        }
+        out.push_back(' ');
+        out.append(number(value));
+        out.push_back('\n');
+        return *this;
+    }
+
+    // _bucket (cumulative), _sum and _count samples of a histogram; `label` identifies the series.
+    PrometheusWriter& histogram(std::string_view name, std::pair<std::string_view, std::string_view> label,
+                                const LatencyHistogram::Snapshot& h) {
+        const std::string bucket = std::string(name) + "_bucket";
+        std::uint64_t cumulative = 0;
+        for (std::size_t b = 0; b < h.buckets.size(); ++b) {
+            cumulative += h.buckets[b];
+            const std::string le = b < LatencyHistogram::bounds.size() ? number(LatencyHistogram::bounds[b]) : "+Inf";
+            sample(bucket, {label, {"le", le}}, static_cast<double>(cumulative));
+        }
+        sample(std::string(name) + "_sum", {label}, h.sum);
+        sample(std::string(name) + "_count", {label}, static_cast<double>(h.count));
+        return *this;
+    }
+
+private:
+    void appendEscaped(std::string_view s) {
+        for (char c : s) {
+            if (c == '\\' || c == '"')
+                out.push_back('\\');
+            if (c == '\n')
+                out.append("\\n");
+            else
+                out.push_back(c);
+        }
+    }
+
+    // Shortest form that reads back as the same double.
+    static std::string number(double v) {
+        char buf[400];
+        const auto end = std::to_chars(buf, buf + sizeof buf, v, std::chars_format::fixed).ptr;
+        return std::string(buf, end);
+    }
+
+    std::string& out;
+};
+
+/**
+ * @brief Request and algorithm telemetry of the server.
+ *
+ * Routes and algorithms are registered up front; from then on the registry is
+ * read-only and recording only touches ShardedCounter and LatencyHistogram
+ * shards, with no lock. Requests to paths that are not registered are
+ * counted under "unmatched", so a scan of random URLs cannot grow the
+ * number of series. Per-graph totals are the exception: graphs come and go,
+ * so they live in a map under a mutex, taken once per algorithm run, and
+ * retainGraphs() drops the graphs no longer stored; calling it before each
+ * write() keeps one series per stored graph at most.
+ */
+class Metrics {
+public:
+    // Not thread-safe: call before recording starts.
+    void addRoute(std::string route) { routes.emplace(std::move(route), std::make_unique<RouteStats>()); }
+    void addAlgorithm(std::string name) { algorithms.emplace(std::move(name), std::make_unique<AlgorithmStats>()); }
+
+    void observeRequest(std::string_view route, int status, std::chrono::nanoseconds elapsed) {
+        RouteStats& stats = routeStats(route);
+        stats.responses[std::clamp(status / 100, 1, 5) - 1].add();
+        stats.latency.observe(elapsed);
+    }
+
+    // Work of one run, as counted by its trace; the run time is the sum of its phases.
+    void observeAlgorithm(std::string_view algorithm, int graphId, const CountingTrace& trace) {
+        auto it = algorithms.find(algorithm);
+        if (it == algorithms.end())
+            return;
+        std::chrono::nanoseconds elapsed{0};
+        for (auto phase : trace.phaseTime)
+            elapsed += phase;
+        AlgorithmStats& stats = *it->second;
+        stats.runs.add();
+        stats.verticesSettled.add(trace.verticesSettled);
+        stats.edgesRelaxed.add(trace.edgesRelaxed);
+        stats.heapPushes.add(trace.heapPushes);
+        stats.latency.observe(elapsed);
+
+        std::lock_guard lock(graphMutex);
+        GraphStats& graph = graphs[graphId];
+        ++graph.runs;
+        graph.seconds += std::chrono::duration<double>(elapsed).count();
+    }
+
+    // Forgets the per-graph totals of every graph not in `stored`.
+    void retainGraphs(std::vector<int> stored) {
+        std::sort(stored.begin(), stored.end());
+        std::lock_guard lock(graphMutex);
+        std::erase_if(graphs, [&](const auto& entry) {
+            return !std::binary_search(stored.begin(), stored.end(), entry.first);
+        });
+    }
+
+    void write(PrometheusWriter& w) const {
+        static constexpr std::array<std::string_view, 5> classes{"1xx", "2xx", "3xx", "4xx", "5xx"};
+        w.family("graph_http_requests_total", "counter", "HTTP requests handled, by route and status class.");
+        forEachRoute([&](std::string_view route, const RouteStats& stats) {
+            for (std::size_t c = 0; c < classes.size(); ++c) {
+                if (const auto n = stats.responses[c].value())
+                    w.sample("graph_http_requests_total", {{"route", route}, {"code", classes[c]}}, static_cast<double>(n));
+            }
+        });
+        w.family("graph_http_request_duration_seconds", "histogram", "Time from request to response, by route.");
+        forEachRoute([&](std::string_view route, const RouteStats& stats) {
+            w.histogram("graph_http_request_duration_seconds", {"route", route}, stats.latency.snapshot());
+        });
+
+        w.family("graph_algorithm_runs_total", "counter", "Algorithm runs completed (cache hits excluded).");
+        for (const auto& [name, stats] : algorithms)
+            w.sample("graph_algorithm_runs_total", {{"algorithm", name}}, static_cast<double>(stats->runs.value()));
+        w.family("graph_algorithm_vertices_settled_total", "counter", "Vertices settled or visited by algorithm runs.");
+        for (const auto& [name, stats] : algorithms)
+            w.sample("graph_algorithm_vertices_settled_total", {{"algorithm", name}},
+                     static_cast<double>(stats->verticesSettled.value()));
+        w.family("graph_algorithm_edges_relaxed_total", "counter", "Edges scanned or relaxed by algorithm runs.");
+        for (const auto& [name, stats] : algorithms)
+            w.sample("graph_algorithm_edges_relaxed_total", {{"algorithm", name}},
+                     static_cast<double>(stats->edgesRelaxed.value()));
+        w.family("graph_algorithm_heap_pushes_total", "counter", "Priority queue insertions by algorithm runs.");
+        for (const auto& [name, stats] : algorithms)
+            w.sample("graph_algorithm_heap_pushes_total", {{"algorithm", name}},
+                     static_cast<double>(stats->heapPushes.value()));
+        w.family("graph_algorithm_duration_seconds", "histogram", "Algorithm run time, serialization excluded.");
+        for (const auto& [name, stats] : algorithms)
+            w.histogram("graph_algorithm_duration_seconds", {"algorithm", name}, stats->latency.snapshot());
+
+        std::lock_guard lock(graphMutex);
+        w.family("graph_graph_algorithm_runs_total", "counter", "Algorithm runs, by graph.");
+        for (const auto& [id, graph] : graphs)
+            w.sample("graph_graph_algorithm_runs_total", {{"graph_id", std::to_string(id)}}, static_cast<double>(graph.runs));
+        w.family("graph_graph_algorithm_seconds_total", "counter", "Time spent in algorithm runs, by graph.");
+        for (const auto& [id, graph] : graphs)
+            w.sample("graph_graph_algorithm_seconds_total", {{"graph_id", std::to_string(id)}}, graph.seconds);
+    }
+
+private:
+    struct RouteStats {
+        std::array<ShardedCounter, 5> responses; // 1xx .. 5xx
+        LatencyHistogram latency;
+    };
+
+    struct AlgorithmStats {
+        ShardedCounter runs, verticesSettled, edgesRelaxed, heapPushes;
+        LatencyHistogram latency;
+    };
+
+    struct GraphStats {
+        std::uint64_t runs = 0;
+        double seconds = 0.0;
+    };
+
+    RouteStats& routeStats(std::string_view route) {
+        auto it = routes.find(route);
+        return it == routes.end() ? unmatched : *it->second;
+    }
+
+    template <typename F>
+    void forEachRoute(F&& f) const {
+        for (const auto& [route, stats] : routes)
+            f(route, *stats);
+        f("unmatched", unmatched);
+    }
+
+    std::map<std::string, std::unique_ptr<RouteStats>, std::less<>> routes;
+    RouteStats unmatched;
+    std::map<std::string, std::unique_ptr<AlgorithmStats>, std::less<>> algorithms;
+    mutable std::mutex graphMutex;
+    std::map<int, GraphStats> graphs;
+};
@@ -1,11 +1,389 @@
 #include "api/GraphAPI.hpp"
+#include "api/GraphUpload.hpp"
 #include "graph_repository/GraphRepository.hpp"
+#include "graph_repository/ResultCache.hpp"
+#include "jobs/JobManager.hpp"
+#include "metrics/Metrics.hpp"
 #include "graph_core/GraphGenerator.hpp"
 #include "graph_core/Algorithms.hpp"
+#include "graph_core/ParallelBFS.hpp"
+#include "graph_core/MultiSourceBFS.hpp"
+#include "graph_core/ConnectedComponents.hpp"
+#include "graph_core/Centrality.hpp"
+#include "graph_core/DeltaStepping.hpp"
+#include "graph_core/DynamicShortestPaths.hpp"
+#include "graph_core/ShortestPath.hpp"
+#include "graph_core/ContractionHierarchy.hpp"
+#include "graph_core/FloydWarshall.hpp"
+#include "graph_core/Parallel.hpp"
+#include "graph_core/Trace.hpp"
+#include "graph_core/VertexOrder.hpp"
 
-static GraphRepository repository;
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// Presupuesto de memoria de los grafos residentes (GRAPH_MEMORY_BUDGET_MB, 0 o ausente = sin límite);
+// los menos usados se vuelcan a disco en GRAPH_SPILL_DIR (por defecto, el directorio temporal).
+static GraphRepository makeRepository() {
+    const char* budget = std::getenv("GRAPH_MEMORY_BUDGET_MB");
+    const char* spillDir = std::getenv("GRAPH_SPILL_DIR");
+    return GraphRepository(budget ? std::strtoull(budget, nullptr, 10) << 20 : 0,
+                           spillDir ? std::filesystem::path(spillDir) : std::filesystem::path());
+}
+
+static GraphRepository repository = makeRepository();
+
+// Caché de resultados de /run_algorithm (GRAPH_RESULT_CACHE_MB, 64 por defecto; 0 la desactiva)
+static ResultCache makeResultCache() {
+    const char* capacity = std::getenv("GRAPH_RESULT_CACHE_MB");
+    return ResultCache(capacity ? std::strtoull(capacity, nullptr, 10) << 20 : std::size_t{64} << 20);
+}
+
+static ResultCache resultCache = makeResultCache();
+
+// Telemetría de /metrics; antes que `jobs`, porque los trabajos en curso la usan hasta el final
+static Metrics metrics;
+
+// Nombres que acepta /run_algorithm, uno por serie de contadores de trabajo
+static constexpr const char* algorithmNames[] = {
+    "bfs", "bfs_parallel", "dfs", "dijkstra", "delta_stepping", "components", "weak_components",
+    "pagerank", "personalized_pagerank", "katz", "floyd_warshall"};
+
+// Trabajos asíncronos de /jobs: GRAPH_JOB_THREADS hilos (0 o ausente = los del equipo), como
+// mucho GRAPH_JOBS_PER_GRAPH trabajos simultáneos por grafo (2 por defecto), y resultados de
+// trabajos terminados guardados hasta GRAPH_JOB_RESULTS_MB (256 por defecto)
+static JobManager makeJobManager() {
+    const char* threads = std::getenv("GRAPH_JOB_THREADS");
+    const char* perGraph = std::getenv("GRAPH_JOBS_PER_GRAPH");
+    const char* results = std::getenv("GRAPH_JOB_RESULTS_MB");
+    return JobManager(threads ? static_cast<unsigned>(std::strtoul(threads, nullptr, 10)) : 0,
+                      perGraph ? static_cast<unsigned>(std::strtoul(perGraph, nullptr, 10)) : 2, 1024,
+                      results ? std::strtoull(results, nullptr, 10) << 20 : std::size_t{256} << 20);
+}
+
+static JobManager jobs = makeJobManager();
+
+// Cambios de aristas de cada grafo (/update_graph): el mutex ordena sus lotes, y las SSSP
+// incrementales registradas con /dynamic_sssp se reparan con cada lote bajo ese mismo mutex
+struct GraphEdits {
+    std::mutex mutex;
+    std::map<int, DynamicShortestPaths<int>> paths; // por nodo origen
+};
+
+static std::mutex graphEditsMutex;
+static std::unordered_map<int, std::shared_ptr<GraphEdits>> graphEdits;
+
+static std::shared_ptr<GraphEdits> editsOf(int graphId) {
+    std::lock_guard lock(graphEditsMutex);
+    auto& edits = graphEdits[graphId];
+    if (!edits) edits = std::make_shared<GraphEdits>();
+    return edits;
+}
+
+// Lista "changes" de /update_graph: {"op": "add" | "remove" | "set_weight", "from", "to", "weight"}
+static std::vector<EdgeChange<int>> parseEdgeChanges(const crow::json::rvalue& list) {
+    std::vector<EdgeChange<int>> changes;
+    changes.reserve(list.size());
+    for (const auto& item : list.lo()) {
+        if (item.t() != crow::json::type::Object || !item.has("from") || !item.has("to")) {
+            throw std::invalid_argument("Each change needs from and to");
+        }
+        EdgeChange<int> change;
+        std::string op = item.has("op") ? std::string(item["op"].s()) : "add";
+        if (op == "add") change.kind = EdgeChange<int>::Kind::Insert;
+        else if (op == "remove") change.kind = EdgeChange<int>::Kind::Remove;
+        else if (op == "set_weight") change.kind = EdgeChange<int>::Kind::SetWeight;
+        else throw std::invalid_argument("Unknown op: " + op);
+        if (op == "set_weight" && !item.has("weight")) {
+            throw std::invalid_argument("set_weight needs a weight");
+        }
+        change.from = static_cast<int>(item["from"].i());
+        change.to = static_cast<int>(item["to"].i());
+        if (item.has("weight")) change.weight = static_cast<int>(item["weight"].i());
+        changes.push_back(change);
+    }
+    return changes;
+}
+
+// Parámetro "vertex_order" de /generate_graph y /upload_graph; sin él, el orden de los IDs
+static std::optional<VertexOrder> vertexOrderParam(const char* value) {
+    return value ? parseVertexOrder(value) : VertexOrder::Original;
+}
+
+// Parámetro "threads" de los algoritmos paralelos: 0 o ausente = automático. Más hilos que los del
+// equipo no aceleran nada, y un valor enorme agotaría los recursos del proceso: nullopt si está
+// fuera de [0, hilos del equipo]
+static std::optional<unsigned> threadsParam(const crow::json::rvalue& body) {
+    if (!body.has("threads")) return 0u;
+    const std::int64_t threads = body["threads"].i();
+    if (threads < 0 || threads > static_cast<std::int64_t>(Parallel::defaultThreads())) return std::nullopt;
+    return static_cast<unsigned>(threads);
+}
+
+static crow::response invalidThreads() {
+    return crow::response(400, "threads must be between 0 and " + std::to_string(Parallel::defaultThreads()));
+}
+
+// Tope de max_iterations de las centralidades: cada iteración recorre todas las aristas
+static constexpr std::int64_t maxCentralityIterations = 10000;
+
+// Respuesta JSON escrita en una sola pasada directamente sobre el cuerpo, sin DOM intermedio.
+// writeFields(w) escribe los miembros del objeto raíz; reserveBytes es una estimación del tamaño.
+template<typename F>
+static crow::response jsonResponse(std::size_t reserveBytes, F&& writeFields) {
+    crow::response res;
+    res.body.reserve(reserveBytes);
+    JsonWriter w(res.body);
+    w.beginObject();
+    writeFields(w);
+    w.endObject();
+    res.set_header("Content-Type", "application/json");
+    return res;
+}
+
+// Directorio de ficheros de grafo (GRAPH_DATA_DIR): se cargan al arrancar y se guardan al parar
+// o con /save_graphs. Vacío si no está definido.
+static std::filesystem::path dataDirectory() {
+    const char* dir = std::getenv("GRAPH_DATA_DIR");
+    return dir ? std::filesystem::path(dir) : std::filesystem::path();
+}
+
+std::size_t GraphAPI::restoreGraphs() {
+    auto dir = dataDirectory();
+    return dir.empty() ? 0 : repository.loadAll<int>(dir);
+}
+
+std::size_t GraphAPI::persistGraphs() {
+    auto dir = dataDirectory();
+    return dir.empty() ? 0 : repository.saveAll(dir);
+}
+
+// Ejecuta una petición de /run_algorithm (también la de un trabajo de /jobs). Con `cancelled`,
+// la ejecución se interrumpe con OperationCancelled en cuanto se activa la marca.
+static crow::response runAlgorithmRequest(const crow::json::rvalue& body, const std::atomic<bool>* cancelled) {
+    int graphId     = body["graph_id"].i();
+    std::string alg = body["algorithm"].s();
+
+    // floyd_warshall trabaja sobre grafos matriz; el resto, sobre la forma CSR de las listas
+    // La instantánea fija la versión del grafo durante toda la ejecución
+    GraphRepository::SnapshotPtr snapshot;
+    try {
+        snapshot = repository.snapshot(graphId);
+    } catch (const std::exception& e) {
+        return crow::response(404, "Graph not found");
+    }
+    bool isMatrix = snapshot->holds<AdjacencyMatrixGraph<int>>();
+    if (alg == "floyd_warshall" && !isMatrix) {
+        return crow::response(400, "floyd_warshall requires an adjacency matrix graph");
+    }
+    if (alg != "floyd_warshall" && isMatrix) {
+        return crow::response(400, "Algorithm requires an adjacency list graph");
+    }
+    // las componentes y las centralidades recorren todo el grafo: no tienen nodo de origen
+    bool components = alg == "components" || alg == "weak_components";
+    bool centrality = alg == "pagerank" || alg == "personalized_pagerank" || alg == "katz";
+    if (!isMatrix && !components && !centrality && !body.has("start_node")) {
+        return crow::response(400, "Missing start_node");
+    }
+    if (!isMatrix && !components && !centrality && alg != "bfs" && alg != "bfs_parallel" && alg != "dfs"
+        && alg != "dijkstra" && alg != "delta_stepping") {
+        return crow::response(400, "Unknown algorithm");
+    }
+    int start = isMatrix || components || centrality ? 0 : static_cast<int>(body["start_node"].i());
+    const auto threads = threadsParam(body);
+    if (!threads) return invalidThreads();
+
+    // Parámetros de las centralidades: cambian el resultado, así que van también en la clave de la caché
+    Algorithms::PageRankOptions pageRankOptions;
+    Algorithms::KatzOptions katzOptions;
+    std::vector<int> sources;
+    std::string cacheKey = alg;
+    if (centrality) {
+        if (body.has("damping")) pageRankOptions.damping = body["damping"].d();
+        if (body.has("alpha")) katzOptions.alpha = body["alpha"].d();
+        if (body.has("beta")) katzOptions.beta = body["beta"].d();
+        if (body.has("normalized")) katzOptions.normalized = body["normalized"].b();
+        if (body.has("tolerance")) pageRankOptions.tolerance = katzOptions.tolerance = body["tolerance"].d();
+        if (body.has("max_iterations")) {
+            const std::int64_t iterations = body["max_iterations"].i();
+            if (iterations < 1 || iterations > maxCentralityIterations) {
+                return crow::response(400, "max_iterations must be between 1 and " + std::to_string(maxCentralityIterations));
+            }
+            pageRankOptions.maxIterations = katzOptions.maxIterations = static_cast<std::size_t>(iterations);
+        }
+        // Escritas así para que un NaN tampoco pase
+        if (!(pageRankOptions.damping >= 0.0 && pageRankOptions.damping < 1.0)) {
+            return crow::response(400, "damping must be in [0, 1)");
+        }
+        if (!(katzOptions.alpha > 0.0)) return crow::response(400, "alpha must be positive");
+        if (!(pageRankOptions.tolerance > 0.0)) return crow::response(400, "tolerance must be positive");
+        if (alg == "personalized_pagerank") {
+            if (!body.has("sources") || body["sources"].t() != crow::json::type::List) {
+                return crow::response(400, "Missing sources");
+            }
+            for (const auto& s : body["sources"].lo()) sources.push_back(static_cast<int>(s.i()));
+        }
+
+        std::ostringstream key;
+        key.precision(17);
+        key << alg << '|' << pageRankOptions.damping << '|' << katzOptions.alpha << '|' << katzOptions.beta
+            << '|' << katzOptions.normalized << '|' << pageRankOptions.tolerance << '|' << pageRankOptions.maxIterations;
+        for (int s : sources) key << '|' << s;
+        cacheKey = key.str();
+    }
+
+    // Sin traza, la respuesta solo depende de (grafo, versión, algoritmo y parámetros, origen):
+    // un acierto en la caché devuelve los bytes ya serializados sin ejecutar nada
+    bool traced = body.has("trace") && body["trace"].b();
+    if (!traced) {
+        if (auto cached = resultCache.find(graphId, snapshot->version(), cacheKey, start)) {
+            crow::response res;
+            res.body = *cached;
+            res.set_header("Content-Type", "application/json");
+            res.set_header("X-Cache", "hit");
+            return res;
+        }
+    }
+
+    const CsrGraph<int>* csr = isMatrix ? nullptr : &snapshot->csr<int>();
+
+    Algorithms::ParallelBFSOptions bfsOptions;
+    Algorithms::DeltaSteppingOptions deltaOptions;
+    Algorithms::FloydWarshallOptions floydOptions;
+    Algorithms::ComponentsOptions componentsOptions;
+    bfsOptions.threads = deltaOptions.threads = floydOptions.threads = componentsOptions.threads =
+        pageRankOptions.threads = katzOptions.threads = *threads;
+    if (body.has("delta")) {
+        deltaOptions.delta = body["delta"].d();
+        if (!(deltaOptions.delta > 0.0)) return crow::response(400, "delta must be positive");
+    }
+    if (body.has("tile_size")) floydOptions.tileSize = static_cast<std::size_t>(body["tile_size"].i());
+
+    // Ejecuta el algoritmo con la política de traza indicada y escribe el resultado.
+    auto runAlgorithm = [&](auto& trace, JsonWriter& w) {
+        if (isMatrix) {
+            GraphAPI::writeFields(w, Algorithms::FloydWarshall(
+                snapshot->graph<AdjacencyMatrixGraph<int>>(), floydOptions, trace));
+            return;
+        }
+        const auto& graph = *csr;
+        if (alg == "bfs") {
+            GraphAPI::writeFields(w, Algorithms::BFS(graph, start, trace));
+        } else if (alg == "bfs_parallel") {
+            GraphAPI::writeFields(w, Algorithms::ParallelBFS(
+                graph, snapshot->reverseCsr<int>(), start, bfsOptions, trace));
+        } else if (alg == "dfs") {
+            GraphAPI::writeFields(w, Algorithms::DFS(graph, start, trace));
+        } else if (alg == "dijkstra") {
+            GraphAPI::writeFields(w, Algorithms::Dijkstra(graph, start, trace));
+        } else if (alg == "components") {
+            // dirigido: fuertemente conexas; no dirigido: conexas (reverseCsr es el propio grafo)
+            const auto& reverse = snapshot->reverseCsr<int>();
+            GraphAPI::writeFields(w, graph.isDirected()
+                ? Algorithms::StronglyConnectedComponents(graph, reverse, componentsOptions, trace)
+                : Algorithms::ConnectedComponents(graph, reverse, componentsOptions, trace));
+        } else if (alg == "weak_components") {
+            GraphAPI::writeFields(w, Algorithms::ConnectedComponents(
+                graph, snapshot->reverseCsr<int>(), componentsOptions, trace));
+        } else if (alg == "pagerank") {
+            GraphAPI::writeFields(w, Algorithms::PageRank(
+                graph, snapshot->reverseCsr<int>(), pageRankOptions, trace));
+        } else if (alg == "personalized_pagerank") {
+            GraphAPI::writeFields(w, Algorithms::PersonalizedPageRank(
+                graph, snapshot->reverseCsr<int>(), sources, pageRankOptions, trace));
+        } else if (alg == "katz") {
+            GraphAPI::writeFields(w, Algorithms::KatzCentrality(
+                graph, snapshot->reverseCsr<int>(), katzOptions, trace));
+        } else {
+            GraphAPI::writeFields(w, Algorithms::DeltaStepping(graph, start, deltaOptions, trace));
+        }
+    };
+
+    // unos 60 bytes por vértice (entradas de parent/depth o dist); FW, una matriz de distancias
+    std::size_t n = isMatrix ? snapshot->graph<AdjacencyMatrixGraph<int>>().size() : csr->vertexCount();
+    std::size_t estimate = isMatrix ? n * n * 4 : n * 60;
+
+    // Con `cancelled` (trabajos de /jobs) la traza comprueba la cancelación entre fases y en cada vértice asentado
+    auto run = [&](JsonWriter& w, auto trace) {
+        if (cancelled) {
+            CancellableTrace<decltype(trace)> cancellable(*cancelled, trace);
+            runAlgorithm(cancellable, w);
+            return cancellable.inner;
+        }
+        runAlgorithm(trace, w);
+        return trace;
+    };
+
+    // Los contadores de la ejecución alimentan siempre /metrics; con "trace": true se
+    // añaden además al resultado (y la respuesta no pasa por la caché)
+    if (traced) {
+        return jsonResponse(estimate, [&](JsonWriter& w) {
+            CountingTrace trace = run(w, CountingTrace{});
+            metrics.observeAlgorithm(alg, graphId, trace);
+            w.key("stats");
+            GraphAPI::write(w, trace);
+        });
+    }
+    auto res = jsonResponse(estimate, [&](JsonWriter& w) {
+        metrics.observeAlgorithm(alg, graphId, run(w, CountingTrace{}));
+    });
+    resultCache.store(graphId, snapshot->version(), cacheKey, start, res.body);
+    res.set_header("X-Cache", "miss");
+    return res;
+}
+
+// Estado de un trabajo: tiempo en cola y, si ha empezado, en ejecución (hasta ahora si sigue)
+static crow::response jobStatus(const JobManager::Info& job) {
+    using State = JobManager::State;
+    using Ms = std::chrono::duration<double, std::milli>;
+    const auto now = JobManager::Clock::now();
+    const bool started = job.started != JobManager::Clock::time_point{};
+    const auto dequeued = started ? job.started : job.state == State::Queued ? now : job.finished;
+
+    crow::json::wvalue res;
+    res["job_id"] = job.id;
+    res["graph_id"] = job.graphId;
+    res["algorithm"] = job.label;
+    res["status"] = JobManager::stateName(job.state);
+    res["queued_ms"] = Ms(dequeued - job.submitted).count();
+    if (started) {
+        res["run_ms"] = Ms((job.state == State::Running ? now : job.finished) - job.started).count();
+    }
+    if (job.state == State::Failed) {
+        res["error"] = *job.result;
+        res["error_status"] = job.status;
+    }
+    return crow::response(res);
+}
+
+void GraphAPI::registerEndpoints(App& app) {
+    // Rutas con serie propia en /metrics (las demás cuentan como "unmatched"); los segmentos
+    // numéricos de la URL se agrupan como <int>
+    for (const char* route : {"/generate_graph", "/upload_graph", "/run_algorithm", "/jobs", "/jobs/<int>",
+                              "/jobs/<int>/result", "/multi_bfs", "/get_graph/<int>", "/shortest_path",
+                              "/update_graph/<int>", "/dynamic_sssp", "/build_index/<int>", "/save_graphs",
+                              "/metrics"}) {
+        metrics.addRoute(route);
+    }
+    for (const char* algorithm : algorithmNames) {
+        metrics.addAlgorithm(algorithm);
+    }
+    app.get_middleware<MetricsMiddleware>().metrics = &metrics;
 
-void GraphAPI::registerEndpoints(crow::SimpleApp& app) {
     // Endpoint: /generate_graph
     CROW_ROUTE(app, "/generate_graph").methods("POST"_method)
     ([](const crow::request& req){
@@ -16,17 +394,71 @@ void GraphAPI::registerEndpoints(crow::SimpleApp& app) {
         size_t nodeCount = body["node_count"].i();
         double edgeProb  = body["edge_probability"].d();
         bool directed    = body["directed"].b();
+        // Misma semilla, mismo grafo; sin semilla se elige una y se devuelve
+        std::uint64_t seed = body.has("seed") ? body["seed"].u() : std::random_device{}();
+        const auto threads = threadsParam(body);
+        if (!threads) return invalidThreads();
+
+        std::string type   = body.has("type") ? std::string(body["type"].s()) : "adjacency_list";
+        auto order = vertexOrderParam(body.has("vertex_order") ? std::string(body["vertex_order"].s()).c_str() : nullptr);
+        if (!order) return crow::response(400, "Unknown vertex order");
+        if (*order != VertexOrder::Original && type != "adjacency_list") {
+            return crow::response(400, "Vertex reordering requires an adjacency list graph");
+        }
+
+        // Crear grafo y guardarlo en el repositorio
+        int id;
+        if (type == "adjacency_list") {
+            id = repository.addGraph(GraphGenerator::generateAdjacencyListGraph<int>(
+                nodeCount, edgeProb, 1, 10, directed, seed, *threads
+            ), *order);
+        } else if (type == "adjacency_matrix") {
+            id = repository.addGraph(GraphGenerator::generateAdjacencyMatrixGraph<int>(
+                nodeCount, edgeProb, 1, 10, directed, seed, *threads
+            ));
+        } else {
+            return crow::response(400, "Unknown graph type");
+        }
+
+        crow::json::wvalue res;
+        res["graph_id"] = id;
+        res["seed"] = seed;
+        res["vertex_order"] = vertexOrderName(*order);
+        res["memory_bytes"] = repository.graphBytes(id);
+        return crow::response(res);
+    });
 
-        // Crear grafo
-        auto graph = GraphGenerator::generateAdjacencyListGraph<int>(
-            nodeCount, edgeProb, 1, 10, directed
-        );
+    // Endpoint: /upload_graph
+    // El cuerpo es un grafo en formato "list" o "matrix" (el de /get_graph). Se lee con un parser
+    // SAX, sin construir el árbol JSON, y el grafo se construye en bloque a partir de las aristas.
+    // El orden de los vértices va en la URL: /upload_graph?vertex_order=rcm
+    CROW_ROUTE(app, "/upload_graph").methods("POST"_method)
+    ([](const crow::request& req){
+        auto order = vertexOrderParam(req.url_params.get("vertex_order"));
+        if (!order) return crow::response(400, "Unknown vertex order");
 
-        // Guardar en repositorio
-        int id = repository.addGraph(std::move(graph));
+        auto started = std::chrono::steady_clock::now();
+        int id;
+        std::size_t edges;
+        try {
+            auto upload = GraphUpload<int>::parse(req.body);
+            edges = upload.edgeCount();
+            if (upload.isMatrix() && *order != VertexOrder::Original) {
+                return crow::response(400, "Vertex reordering requires an adjacency list graph");
+            }
+            id = upload.isMatrix() ? repository.addGraph(upload.buildMatrix())
+                                   : repository.addGraph(upload.buildList(), *order);
+        } catch (const std::invalid_argument& e) {
+            return crow::response(400, e.what());
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - started;
 
         crow::json::wvalue res;
         res["graph_id"] = id;
+        res["edges"] = edges;
+        res["vertex_order"] = vertexOrderName(*order);
+        res["memory_bytes"] = repository.graphBytes(id);
+        res["upload_ms"] = elapsed.count();
         return crow::response(res);
     });
 
@@ -35,46 +467,467 @@ void GraphAPI::registerEndpoints(crow::SimpleApp& app) {
     ([](const crow::request& req){
         auto body = crow::json::load(req.body);
         if (!body) return crow::response(400);
+        return runAlgorithmRequest(body, nullptr);
+    });
 
-        int graphId     = body["graph_id"].i();
-        std::string alg = body["algorithm"].s();
-        int start       = body["start_node"].i();
+    // Endpoint: /jobs
+    // Lanza una petición de /run_algorithm como trabajo asíncrono y responde en el acto (202)
+    CROW_ROUTE(app, "/jobs").methods("POST"_method)
+    ([](const crow::request& req){
+        auto body = crow::json::load(req.body);
+        if (!body || !body.has("graph_id") || !body.has("algorithm")) return crow::response(400);
 
-        auto& graph = repository.getGraph<AdjacencyListGraph<int>>(graphId);
+        int graphId = body["graph_id"].i();
+        if (!repository.contains(graphId)) {
+            return crow::response(404, "Graph not found");
+        }
+        if (!threadsParam(body)) return invalidThreads();
+        // el trabajo vuelve a leer su propia copia del cuerpo
+        auto id = jobs.submit(graphId, std::string(body["algorithm"].s()),
+            [request = req.body](const std::atomic<bool>& cancelled) {
+                crow::response res = runAlgorithmRequest(crow::json::load(request), &cancelled);
+                return JobManager::Outcome{res.code, std::move(res.body)};
+            });
 
-        nlohmann::json result_json;
-        if (alg == "bfs") {
-            TraversalResult result = Algorithms::BFS(graph, start);
-            result_json = GraphAPI::serialize(result);
-        } else if (alg == "dfs") {
-            TraversalResult result = Algorithms::DFS(graph, start);
-            result_json = GraphAPI::serialize(result);
-        } else if (alg == "dijkstra") {
-            DijkstraResult result = Algorithms::Dijkstra(graph, start);
-            result_json = GraphAPI::serialize(result);
-        } else {
-            return crow::response(400, "Unknown algorithm");
+        crow::json::wvalue res;
+        res["job_id"] = id;
+        res["status"] = "queued";
+        res["status_url"] = "/jobs/" + std::to_string(id);
+        res["result_url"] = "/jobs/" + std::to_string(id) + "/result";
+        crow::response response(res);
+        response.code = 202;
+        return response;
+    });
+
+    // Endpoint: /jobs/<job_id>
+    // GET consulta el estado; DELETE pide la cancelación (inmediata si aún no ha empezado)
+    CROW_ROUTE(app, "/jobs/<int>").methods("GET"_method, "DELETE"_method)
+    ([](const crow::request& req, int jobId){
+        if (req.method == "DELETE"_method && !jobs.cancel(jobId)) {
+            return crow::response(404, "Job not found");
+        }
+        auto job = jobs.find(jobId);
+        if (!job) {
+            return crow::response(404, "Job not found");
         }
+        return jobStatus(*job);
+    });
 
-        crow::json::wvalue res = crow::json::load(result_json.dump());
+    // Endpoint: /jobs/<job_id>/result
+    // 200 con el resultado, 202 si aún no ha terminado, 409 si se canceló; un trabajo
+    // fallido devuelve el código y el mensaje de error de la ejecución
+    CROW_ROUTE(app, "/jobs/<int>/result").methods("GET"_method)
+    ([](int jobId){
+        auto job = jobs.find(jobId);
+        if (!job) {
+            return crow::response(404, "Job not found");
+        }
+        switch (job->state) {
+            case JobManager::State::Done: {
+                crow::response res(*job->result);
+                res.set_header("Content-Type", "application/json");
+                return res;
+            }
+            case JobManager::State::Failed:
+                return crow::response(job->status, *job->result);
+            case JobManager::State::Cancelled:
+                return crow::response(409, "Job cancelled");
+            default: {
+                crow::response res = jobStatus(*job);
+                res.code = 202;
+                return res;
+            }
+        }
+    });
 
-        return crow::response(res);
+    // Endpoint: /multi_bfs
+    // BFS desde muchos orígenes a la vez: los orígenes comparten el recorrido de aristas
+    // en lotes de 64 (un bit por origen); devuelve agregados y, opcionalmente, profundidades
+    CROW_ROUTE(app, "/multi_bfs").methods("POST"_method)
+    ([](const crow::request& req){
+        auto body = crow::json::load(req.body);
+        if (!body) return crow::response(400);
+        if (!body.has("sources") || body["sources"].t() != crow::json::type::List) {
+            return crow::response(400, "Missing sources");
+        }
+
+        int graphId = body["graph_id"].i();
+        GraphRepository::SnapshotPtr snapshot;
+        try {
+            snapshot = repository.snapshot(graphId);
+        } catch (const std::exception& e) {
+            return crow::response(404, "Graph not found");
+        }
+        if (!snapshot->hasCsr<int>()) {
+            return crow::response(400, "Algorithm requires an adjacency list graph");
+        }
+
+        std::vector<int> sources;
+        sources.reserve(body["sources"].size());
+        for (const auto& s : body["sources"].lo()) sources.push_back(static_cast<int>(s.i()));
+
+        const auto threads = threadsParam(body);
+        if (!threads) return invalidThreads();
+
+        Algorithms::MultiSourceBFSOptions options;
+        options.depths = body.has("depths") && body["depths"].b();
+        options.threads = *threads;
+
+        const auto& graph = snapshot->csr<int>();
+        // profundidades: unos 4 bytes por vértice y origen; agregados: unos 100 bytes por origen
+        std::size_t estimate = sources.size() * (options.depths ? graph.vertexCount() * 4 + 100 : 100);
+        bool traced = body.has("trace") && body["trace"].b();
+        return jsonResponse(estimate, [&](JsonWriter& w) {
+            if (traced) {
+                CountingTrace trace;
+                GraphAPI::writeFields(w, Algorithms::MultiSourceBFS(graph, snapshot->reverseCsr<int>(), sources, options, trace));
+                w.key("stats");
+                GraphAPI::write(w, trace);
+            } else {
+                GraphAPI::writeFields(w, Algorithms::MultiSourceBFS(graph, snapshot->reverseCsr<int>(), sources, options));
+            }
+        });
     });
 
     // Endpoint: /get_graph/<graph_id>
     CROW_ROUTE(app, "/get_graph/<int>").methods("GET"_method)
     ([](int graphId){
+        GraphRepository::SnapshotPtr snapshot;
         try {
-            auto& graph = repository.getGraph<AdjacencyListGraph<int>>(graphId);
+            snapshot = repository.snapshot(graphId);
+        } catch (const std::exception& e) {
+            return crow::response(404, "Graph not found");
+        }
+
+        // unos 40 bytes por arista escrita
+        if (snapshot->holds<AdjacencyMatrixGraph<int>>()) {
+            const auto& graph = snapshot->graph<AdjacencyMatrixGraph<int>>();
+            return jsonResponse(graph.edgeCount() * 40, [&](JsonWriter& w) { GraphAPI::writeFields(w, graph); });
+        } else if (snapshot->holds<GraphFile::MappedGraph<int>>()) {
+            const auto& graph = snapshot->graph<GraphFile::MappedGraph<int>>();
+            return jsonResponse(graph.csr().edgeCount() * 40, [&](JsonWriter& w) { GraphAPI::writeFields(w, graph); });
+        }
+        const auto& graph = snapshot->graph<AdjacencyListGraph<int>>();
+        return jsonResponse(snapshot->csr<int>().edgeCount() * 40, [&](JsonWriter& w) { GraphAPI::writeFields(w, graph); });
+    });
+
+    // Endpoint: /shortest_path
+    CROW_ROUTE(app, "/shortest_path").methods("POST"_method)
+    ([](const crow::request& req){
+        auto body = crow::json::load(req.body);
+        if (!body) return crow::response(400);
+
+        int graphId = body["graph_id"].i();
+        int source  = body["source"].i();
+        int target  = body["target"].i();
+
+        GraphRepository::SnapshotPtr snapshot;
+        try {
+            snapshot = repository.snapshot(graphId);
+        } catch (const std::exception& e) {
+            return crow::response(404, "Graph not found");
+        }
+        if (!snapshot->hasCsr<int>()) {
+            return crow::response(400, "Algorithm requires an adjacency list graph");
+        }
+        const CsrGraph<int>* graph   = &snapshot->csr<int>();
+        const CsrGraph<int>* reverse = &snapshot->reverseCsr<int>();
+
+        // Heurística A*: coordenadas de todos los nodos y "euclidean" (por defecto) o "manhattan"
+        std::string heuristic = body.has("heuristic") ? std::string(body["heuristic"].s()) : "";
+        if (body.has("coordinates") && heuristic.empty()) heuristic = "euclidean";
+        if (!heuristic.empty() && heuristic != "euclidean" && heuristic != "manhattan") {
+            return crow::response(400, "Unknown heuristic");
+        }
+
+        NodeCoordinates coords;
+        if (!heuristic.empty()) {
+            if (!body.has("coordinates")) {
+                return crow::response(400, "Heuristic requires coordinates");
+            }
+            const std::size_t n = graph->vertexCount();
+            coords.x.assign(n, std::nan(""));
+            coords.y.assign(n, std::nan(""));
+            for (const auto& c : body["coordinates"]) {
+                int u = graph->indexOf(static_cast<int>(c["node"].i()));
+                if (u < 0) continue;
+                coords.x[u] = c["x"].d();
+                coords.y[u] = c["y"].d();
+            }
+            for (std::size_t u = 0; u < n; ++u) {
+                if (std::isnan(coords.x[u]) || std::isnan(coords.y[u])) {
+                    return crow::response(400, "Missing coordinates for node " + std::to_string(graph->vertexId(static_cast<int>(u))));
+                }
+            }
+        }
+        double scale = body.has("heuristic_scale") ? body["heuristic_scale"].d() : 1.0;
+
+        // Sin heurística se usa la jerarquía de contracción si existe y está al día
+        bool useIndex = !body.has("use_index") || body["use_index"].b();
+        auto index = heuristic.empty() && useIndex ? repository.getContractionHierarchy<int>(graphId) : nullptr;
+        if (index && index->graphVersion() != snapshot->version()) index = nullptr;
+        std::string method = index ? "contraction_hierarchy" : heuristic.empty() ? "bidirectional_dijkstra" : "astar";
+
+        auto runSearch = [&](auto& trace) {
+            if (index) {
+                return index->query(source, target, trace);
+            } else if (heuristic == "euclidean") {
+                return Algorithms::BidirectionalSearch(*graph, *reverse, source, target, EuclideanHeuristic{&coords, scale}, trace);
+            } else if (heuristic == "manhattan") {
+                return Algorithms::BidirectionalSearch(*graph, *reverse, source, target, ManhattanHeuristic{&coords, scale}, trace);
+            }
+            return Algorithms::BidirectionalSearch(*graph, *reverse, source, target, NoHeuristic{}, trace);
+        };
+
+        bool traced = body.has("trace") && body["trace"].b();
+        return jsonResponse(256, [&](JsonWriter& w) {
+            if (traced) {
+                CountingTrace trace;
+                GraphAPI::writeFields(w, runSearch(trace));
+                w.key("stats");
+                GraphAPI::write(w, trace);
+            } else {
+                NullTrace trace;
+                GraphAPI::writeFields(w, runSearch(trace));
+            }
+            w.field("method", method);
+        });
+    });
+
+    // Endpoint: /update_graph/<graph_id>
+    // Aplica un lote de cambios de aristas a un grafo de lista y publica una versión nueva. El lote
+    // es todo o nada; las SSSP incrementales del grafo solo recalculan la zona afectada
+    CROW_ROUTE(app, "/update_graph/<int>").methods("POST"_method)
+    ([](const crow::request& req, int graphId){
+        auto body = crow::json::load(req.body);
+        if (!body) return crow::response(400);
+        if (!body.has("changes") || body["changes"].t() != crow::json::type::List) {
+            return crow::response(400, "Missing changes");
+        }
+        std::vector<EdgeChange<int>> changes;
+        try {
+            changes = parseEdgeChanges(body["changes"]);
+        } catch (const std::invalid_argument& e) {
+            return crow::response(400, e.what());
+        }
+        if (!repository.contains(graphId)) {
+            return crow::response(404, "Graph not found");
+        }
 
-            nlohmann::json result = GraphAPI::serialize<int>(graph);
+        auto edits = editsOf(graphId);
+        std::lock_guard lock(edits->mutex);
+        auto started = std::chrono::steady_clock::now();
 
-            crow::json::wvalue res = crow::json::load(result.dump());
-            
+        // se edita una copia de la versión actual; un grafo mapeado desde fichero pasa a lista en memoria
+        AdjacencyListGraph<int> graph;
+        {
+            GraphRepository::SnapshotPtr snapshot;
+            try {
+                snapshot = repository.snapshot(graphId);
+            } catch (const std::exception& e) {
+                return crow::response(404, "Graph not found");
+            }
+            if (snapshot->holds<AdjacencyListGraph<int>>()) {
+                graph = snapshot->graph<AdjacencyListGraph<int>>();
+            } else if (snapshot->holds<GraphFile::MappedGraph<int>>()) {
+                graph = GraphFile::toList(snapshot->graph<GraphFile::MappedGraph<int>>());
+            } else {
+                return crow::response(400, "Edge updates require an adjacency list graph");
+            }
+        }
+        try {
+            applyEdgeChanges<int>(graph, changes);
+        } catch (const std::invalid_argument& e) {
+            return crow::response(400, e.what());
+        }
+
+        std::uint64_t version;
+        try {
+            version = repository.updateGraph(graphId, std::move(graph));
+        } catch (const std::exception& e) {
+            return crow::response(404, "Graph not found");
+        }
+        resultCache.invalidate(graphId);
+        std::chrono::duration<double, std::milli> published = std::chrono::steady_clock::now() - started;
+
+        return jsonResponse(200 + edits->paths.size() * 100, [&](JsonWriter& w) {
+            w.field("graph_id", graphId).field("graph_version", version).field("changes", changes.size());
+            w.field("update_ms", published.count());
+            w.key("dynamic_sssp").beginArray();
+            for (auto& [source, paths] : edits->paths) {
+                auto repairStarted = std::chrono::steady_clock::now();
+                auto stats = paths.apply(std::span<const EdgeChange<int>>(changes));
+                std::chrono::duration<double, std::milli> repair = std::chrono::steady_clock::now() - repairStarted;
+                w.beginObject().field("source", source).field("detached", stats.detached)
+                 .field("changed", stats.changed).field("repair_ms", repair.count()).endObject();
+            }
+            w.endArray();
+        });
+    });
+
+    // Endpoint: /dynamic_sssp
+    // POST registra una SSSP incremental (graph_id, source), que /update_graph mantiene al día, y
+    // devuelve sus distancias como dijkstra en /run_algorithm; DELETE la da de baja
+    CROW_ROUTE(app, "/dynamic_sssp").methods("POST"_method, "DELETE"_method)
+    ([](const crow::request& req){
+        auto body = crow::json::load(req.body);
+        if (!body) return crow::response(400);
+        if (!body.has("graph_id") || !body.has("source")) {
+            return crow::response(400, "Missing graph_id or source");
+        }
+        int graphId = static_cast<int>(body["graph_id"].i());
+        int source = static_cast<int>(body["source"].i());
+        if (!repository.contains(graphId)) {
+            return crow::response(404, "Graph not found");
+        }
+
+        auto edits = editsOf(graphId);
+        std::unique_lock lock(edits->mutex);
+        if (req.method == "DELETE"_method) {
+            if (edits->paths.erase(source) == 0) {
+                return crow::response(404, "Source not registered");
+            }
+            crow::json::wvalue res;
+            res["graph_id"] = graphId;
+            res["source"] = source;
+            res["registered"] = false;
             return crow::response(res);
+        }
+
+        auto it = edits->paths.find(source);
+        bool created = it == edits->paths.end();
+        std::chrono::duration<double, std::milli> elapsed{0};
+        if (created) {
+            GraphRepository::SnapshotPtr snapshot;
+            try {
+                snapshot = repository.snapshot(graphId);
+            } catch (const std::exception& e) {
+                return crow::response(404, "Graph not found");
+            }
+            if (!snapshot->hasCsr<int>()) {
+                return crow::response(400, "Algorithm requires an adjacency list graph");
+            }
+            auto started = std::chrono::steady_clock::now();
+            it = edits->paths.emplace(source, DynamicShortestPaths<int>(snapshot->csr<int>(), source)).first;
+            elapsed = std::chrono::steady_clock::now() - started;
+        }
+        auto result = it->second.result();
+        std::uint64_t version = repository.graphVersion(graphId);
+        lock.unlock();
+
+        return jsonResponse(result.dist.size() * 50, [&](JsonWriter& w) {
+            GraphAPI::writeFields(w, result);
+            w.field("graph_version", version).field("created", created).field("build_ms", elapsed.count());
+        });
+    });
+
+    // Endpoint: /build_index/<graph_id>
+    // Construye (o reconstruye) la jerarquía de contracción del grafo para /shortest_path
+    CROW_ROUTE(app, "/build_index/<int>").methods("POST"_method)
+    ([](const crow::request& req, int graphId){
+        ContractionHierarchy<int>::Options options;
+        if (!req.body.empty()) {
+            auto body = crow::json::load(req.body);
+            if (!body) return crow::response(400);
+            if (body.has("witness_settle_limit")) {
+                options.witnessSettleLimit = static_cast<std::size_t>(body["witness_settle_limit"].i());
+            }
+        }
+
+        GraphRepository::SnapshotPtr snapshot;
+        try {
+            snapshot = repository.snapshot(graphId);
         } catch (const std::exception& e) {
             return crow::response(404, "Graph not found");
         }
+        if (!snapshot->hasCsr<int>()) {
+            return crow::response(400, "Index requires an adjacency list graph");
+        }
+        const CsrGraph<int>& graph = snapshot->csr<int>();
+        std::uint64_t version = snapshot->version();
+
+        auto started = std::chrono::steady_clock::now();
+        auto index = std::make_shared<const ContractionHierarchy<int>>(
+            ContractionHierarchy<int>::build(graph, version, options));
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - started;
+        repository.setContractionHierarchy<int>(graphId, index);
+
+        crow::json::wvalue res;
+        res["graph_id"] = graphId;
+        res["graph_version"] = version;
+        res["vertices"] = index->vertexCount();
+        res["shortcuts"] = index->shortcutCount();
+        res["arcs"] = index->arcCount();
+        res["build_ms"] = elapsed.count();
+        return crow::response(res);
     });
 
+    // Endpoint: /save_graphs
+    // Guarda todos los grafos en GRAPH_DATA_DIR en formato binario (ver GraphFile.hpp)
+    CROW_ROUTE(app, "/save_graphs").methods("POST"_method)
+    ([](){
+        auto dir = dataDirectory();
+        if (dir.empty()) {
+            return crow::response(400, "GRAPH_DATA_DIR is not set");
+        }
+
+        auto started = std::chrono::steady_clock::now();
+        std::size_t saved = repository.saveAll(dir);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - started;
+
+        crow::json::wvalue res;
+        res["saved"] = saved;
+        res["directory"] = dir.string();
+        res["save_ms"] = elapsed.count();
+        return crow::response(res);
+    });
+
+    // Endpoint: /metrics
+    // Telemetría en formato de texto de Prometheus: peticiones y latencias por ruta, trabajo
+    // y tiempo de los algoritmos, y el estado del repositorio, la caché y los trabajos
+    CROW_ROUTE(app, "/metrics").methods("GET"_method)
+    ([](){
+        std::string out;
+        out.reserve(32 << 10);
+        PrometheusWriter w(out);
+        // solo series de los grafos que siguen en el repositorio
+        const auto ids = repository.ids();
+        metrics.retainGraphs(ids);
+        metrics.write(w);
+
+        w.family("graph_repository_graphs", "gauge", "Graphs in the repository.")
+         .sample("graph_repository_graphs", {}, static_cast<double>(ids.size()));
+        w.family("graph_repository_resident_bytes", "gauge", "Memory held by the graphs that are not spilled to disk.")
+         .sample("graph_repository_resident_bytes", {}, static_cast<double>(repository.residentBytes()));
+        w.family("graph_repository_memory_budget_bytes", "gauge", "Resident memory allowed before spilling (0 = no limit).")
+         .sample("graph_repository_memory_budget_bytes", {}, static_cast<double>(repository.memoryBudget()));
+        w.family("graph_repository_graph_bytes", "gauge", "Memory of each graph, resident or not.");
+        for (int id : ids) {
+            w.sample("graph_repository_graph_bytes", {{"graph_id", std::to_string(id)}},
+                     static_cast<double>(repository.graphBytes(id)));
+        }
+
+        const auto cache = resultCache.stats();
+        w.family("graph_result_cache_hits_total", "counter", "Result cache hits.")
+         .sample("graph_result_cache_hits_total", {}, static_cast<double>(cache.hits));
+        w.family("graph_result_cache_misses_total", "counter", "Result cache misses.")
+         .sample("graph_result_cache_misses_total", {}, static_cast<double>(cache.misses));
+        w.family("graph_result_cache_evictions_total", "counter", "Result cache entries evicted to make room.")
+         .sample("graph_result_cache_evictions_total", {}, static_cast<double>(cache.evictions));
+        w.family("graph_result_cache_entries", "gauge", "Responses held by the result cache.")
+         .sample("graph_result_cache_entries", {}, static_cast<double>(cache.entries));
+        w.family("graph_result_cache_bytes", "gauge", "Bytes held by the result cache.")
+         .sample("graph_result_cache_bytes", {}, static_cast<double>(cache.bytes));
+
+        const auto states = jobs.stateCounts();
+        w.family("graph_jobs", "gauge", "Retained /jobs jobs, by state.");
+        for (std::size_t s = 0; s < states.size(); ++s) {
+            w.sample("graph_jobs", {{"state", JobManager::stateName(static_cast<JobManager::State>(s))}},
+                     static_cast<double>(states[s]));
+        }
+
+        crow::response res(std::move(out));
+        res.set_header("Content-Type", "text/plain; version=0.0.4");
+        return res;
+    });
 }
@@ -2,11 +2,15 @@
 #include <crow.h>
 
 int main() {
-    crow::SimpleApp app;
+    GraphAPI::App app;
 
+    // Grafos guardados en GRAPH_DATA_DIR: se mapean antes de servir y se guardan al parar
+    GraphAPI::restoreGraphs();
     GraphAPI::registerEndpoints(app);
 
     app.port(8080).multithreaded().run();
 
+    GraphAPI::persistGraphs();
+
     return 0;
 }
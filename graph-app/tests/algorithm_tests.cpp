@@ -1,5 +1,22 @@
 
 #include "graph_core/GraphStorage.hpp"
+#include "graph_core/GraphGenerator.hpp"
+#include "graph_core/CsrGraph.hpp"
+#include "graph_core/ParallelBFS.hpp"
+#include "graph_core/MultiSourceBFS.hpp"
+#include "graph_core/DeltaStepping.hpp"
+#include "graph_core/DynamicShortestPaths.hpp"
+#include "graph_core/ShortestPath.hpp"
+#include "graph_core/ContractionHierarchy.hpp"
+#include "graph_core/ConnectedComponents.hpp"
+#include "graph_core/Centrality.hpp"
+#include "graph_core/FloydWarshall.hpp"
+#include "graph_core/VertexOrder.hpp"
+#include "graph_core/PriorityQueue.hpp"
+#include "graph_core/Parallel.hpp"
+#include <numeric>
+#include <random>
+#include <set>
 #include "graph_core/Algorithms.hpp"
 #include "api/GraphAPI.hpp"
 #include <gtest/gtest.h>
@@ -119,3 +136,629 @@ TEST(AlgorithmsTest, DijkstraDistances) {
         EXPECT_DOUBLE_EQ(r.dist[node], dist);
     }
 }
+
+// ---------- TEST algoritmos sobre CsrGraph ----------
+TEST(AlgorithmsTest, CsrMatchesAdjacencyList) {
+    auto g = GraphGenerator::generateAdjacencyListGraph<int>(40, 0.15, 1, 10, true);
+    CsrGraph<int> csr(g);
+
+    auto b1 = Algorithms::BFS(g, 0);
+    auto b2 = Algorithms::BFS(csr, 0);
+    EXPECT_EQ(b1.order, b2.order);
+    EXPECT_EQ(b1.depth, b2.depth);
+
+    auto d1 = Algorithms::Dijkstra(g, 0);
+    auto d2 = Algorithms::Dijkstra(csr, 0);
+    EXPECT_EQ(d1.dist, d2.dist);
+}
+
+// ---------- TEST grafo dirigido con nodos sumidero ----------
+TEST(AlgorithmsTest, DirectedSinkNodes) {
+    AdjacencyListGraph<int> g(true);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 3); // 2 no tiene aristas de salida
+
+    auto r = Algorithms::BFS(g, 0);
+    EXPECT_EQ(r.order.size(), 3);
+    EXPECT_EQ(r.depth.at(2), 2);
+
+    auto d = Algorithms::Dijkstra(g, 0);
+    EXPECT_EQ(d.dist.at(2), 5);
+    EXPECT_EQ(d.parent.at(2), 1);
+}
+
+// ---------- TEST BFS paralela ----------
+static AdjacencyListGraph<int> randomSparseGraph(int n, int m, bool directed, unsigned seed) {
+    AdjacencyListGraph<int> g(directed);
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> node(0, n - 1), weight(1, 10);
+    for (int i = 0; i < n; ++i) g.addNode(i);
+    for (int i = 0; i < m; ++i) g.addEdge(node(gen), node(gen), weight(gen));
+    return g;
+}
+
+TEST(AlgorithmsTest, ParallelBFSMatchesBFS) {
+    for (bool directed : {false, true}) {
+        CsrGraph<int> csr(randomSparseGraph(20000, 80000, directed, 7));
+        auto reverse = directed ? csr.transposed() : csr;
+
+        auto seq = Algorithms::BFS(csr, 0);
+        Algorithms::ParallelBFSOptions options;
+        options.threads = 4;
+        auto par = Algorithms::ParallelBFS(csr, reverse, 0, options);
+
+        EXPECT_EQ(par.depth, seq.depth);
+        EXPECT_EQ(par.order.size(), seq.order.size());
+        EXPECT_EQ(par.order.front(), 0);
+        // cada padre está en el nivel anterior y tiene una arista hacia el hijo
+        for (const auto& [v, p] : par.parent) {
+            if (p == -1) continue;
+            EXPECT_EQ(par.depth.at(p) + 1, par.depth.at(v));
+            auto nbrs = csr.neighbors(csr.indexOf(p));
+            EXPECT_NE(std::find(nbrs.begin(), nbrs.end(), csr.indexOf(v)), nbrs.end());
+        }
+    }
+}
+
+// ---------- TEST BFS multi-origen ----------
+TEST(AlgorithmsTest, MultiSourceBFSMatchesBFS) {
+    for (bool directed : {false, true}) {
+        // grafo poco denso: varias componentes y niveles con frontera pequeña y grande
+        CsrGraph<int> csr(randomSparseGraph(5000, 6000, directed, 11));
+        auto reverse = directed ? csr.transposed() : csr;
+
+        std::vector<int> sources;
+        for (int s = 0; s < 150; ++s) sources.push_back((s * 37) % 5000);
+        sources.push_back(-5); // no existe
+        sources.push_back(sources.front());
+
+        for (unsigned threads : {1u, 4u}) {
+            Algorithms::MultiSourceBFSOptions options;
+            options.threads = threads;
+            auto multi = Algorithms::MultiSourceBFS(csr, reverse, sources, options);
+            ASSERT_EQ(multi.depth.size(), sources.size());
+
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                auto single = Algorithms::BFS(csr, sources[i]);
+                EXPECT_EQ(multi.depth[i], single.depth);
+                EXPECT_EQ(multi.reached[i], single.order.size());
+
+                int eccentricity = single.order.empty() ? -1 : 0;
+                std::uint64_t sum = 0;
+                for (int v : single.order) {
+                    eccentricity = std::max(eccentricity, single.depth.at(v));
+                    sum += single.depth.at(v);
+                }
+                EXPECT_EQ(multi.eccentricity[i], eccentricity);
+                EXPECT_EQ(multi.distanceSum[i], sum);
+            }
+        }
+
+        // sin profundidades, los mismos agregados
+        Algorithms::MultiSourceBFSOptions aggregates;
+        aggregates.depths = false;
+        auto a = Algorithms::MultiSourceBFS(csr, reverse, sources, aggregates);
+        auto b = Algorithms::MultiSourceBFS(csr, reverse, sources);
+        EXPECT_TRUE(a.depth.empty());
+        EXPECT_EQ(a.reached, b.reached);
+        EXPECT_EQ(a.distanceSum, b.distanceSum);
+        EXPECT_DOUBLE_EQ(a.closeness(0), b.closeness(0));
+    }
+}
+
+// ---------- TEST componentes conexas ----------
+TEST(AlgorithmsTest, ComponentsMatchReachability) {
+    // pocas aristas: muchas componentes pequeñas y alguna mediana
+    for (bool directed : {false, true}) {
+        CsrGraph<int> csr(randomSparseGraph(1500, directed ? 2200 : 1200, directed, 5));
+        auto reverse = csr.transposed();
+        Algorithms::ComponentsOptions options;
+        options.threads = 4;
+        auto r = Algorithms::Components(csr, options);
+        EXPECT_EQ(r.strong, directed);
+
+        // u y v comparten etiqueta si y solo si se alcanzan mutuamente
+        std::size_t total = 0;
+        for (std::size_t s : r.sizes) total += s;
+        EXPECT_EQ(total, csr.vertexCount());
+        for (int u = 0; u < 1500; u += 7) {
+            auto fw = Algorithms::BFS(csr, u);
+            auto bw = Algorithms::BFS(reverse, u);
+            for (const auto& [v, d] : fw.depth) {
+                bool mutual = d != std::numeric_limits<int>::max()
+                              && bw.depth.at(v) != std::numeric_limits<int>::max();
+                EXPECT_EQ(mutual, r.component.at(u) == r.component.at(v)) << u << " " << v;
+            }
+        }
+    }
+
+    // en grafos grandes el reparto entre hilos no cambia las etiquetas
+    for (bool directed : {false, true}) {
+        CsrGraph<int> csr(randomSparseGraph(200000, 260000, directed, 9));
+        Algorithms::ComponentsOptions one, many;
+        one.threads = 1;
+        many.threads = 8;
+        auto a = Algorithms::Components(csr, one);
+        auto b = Algorithms::Components(csr, many);
+        EXPECT_EQ(a.component, b.component);
+        EXPECT_EQ(a.sizes, b.sizes);
+        EXPECT_GT(a.count(), 1000u);
+    }
+}
+
+// ---------- TEST centralidades ----------
+TEST(AlgorithmsTest, CentralityMatchesPowerIteration) {
+    // grafo dirigido con sumideros; referencia secuencial con empuje por aristas de salida
+    const int n = 3000;
+    CsrGraph<int> csr(randomSparseGraph(n, 9000, true, 13));
+    auto reverse = csr.transposed();
+
+    auto reference = [&](const std::vector<double>& teleport, int iterations) {
+        std::vector<double> x = teleport;
+        for (int it = 0; it < iterations; ++it) {
+            std::vector<double> next(n, 0.0);
+            double sinks = 0.0;
+            for (int u = 0; u < n; ++u) {
+                auto nbrs = csr.neighbors(u);
+                if (nbrs.empty()) sinks += x[u];
+                for (int v : nbrs) next[v] += x[u] / nbrs.size();
+            }
+            for (int v = 0; v < n; ++v) next[v] = 0.15 * teleport[v] + 0.85 * (next[v] + sinks * teleport[v]);
+            x = next;
+        }
+        return x;
+    };
+
+    Algorithms::PageRankOptions options;
+    options.threads = 4;
+    auto pr = Algorithms::PageRank(csr, reverse, options);
+    EXPECT_TRUE(pr.converged);
+    auto expected = reference(std::vector<double>(n, 1.0 / n), static_cast<int>(pr.iterations));
+    double sum = 0.0;
+    for (int v = 0; v < n; ++v) {
+        EXPECT_NEAR(pr.score.at(v), expected[v], 1e-12);
+        sum += pr.score.at(v);
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-9);
+
+    // el reparto de filas entre hilos no cambia el resultado
+    options.threads = 1;
+    auto single = Algorithms::PageRank(csr, reverse, options);
+    EXPECT_EQ(single.iterations, pr.iterations);
+    for (int v = 0; v < n; ++v) EXPECT_NEAR(single.score.at(v), pr.score.at(v), 1e-15);
+
+    // personalizado: el teletransporte vuelve solo a los orígenes (el 99999 no existe)
+    options.threads = 3;
+    std::vector<int> sources{5, 17, 99999};
+    auto ppr = Algorithms::PersonalizedPageRank(csr, reverse, sources, options);
+    std::vector<double> teleport(n, 0.0);
+    teleport[5] = teleport[17] = 0.5;
+    expected = reference(teleport, static_cast<int>(ppr.iterations));
+    for (int v = 0; v < n; ++v) EXPECT_NEAR(ppr.score.at(v), expected[v], 1e-12);
+
+    // Katz sin normalizar: x = alpha * A^T x + beta por iteración de punto fijo
+    Algorithms::KatzOptions katzOptions;
+    katzOptions.threads = 4;
+    katzOptions.alpha = 0.05;
+    katzOptions.normalized = false;
+    auto katz = Algorithms::KatzCentrality(csr, reverse, katzOptions);
+    EXPECT_TRUE(katz.converged);
+    std::vector<double> x(n, 0.0);
+    for (std::size_t it = 0; it < katz.iterations; ++it) {
+        std::vector<double> next(n, katzOptions.beta);
+        for (int u = 0; u < n; ++u)
+            for (int v : csr.neighbors(u)) next[v] += katzOptions.alpha * x[u];
+        x = next;
+    }
+    for (int v = 0; v < n; ++v) EXPECT_NEAR(katz.score.at(v), x[v], 1e-9);
+
+    // alpha demasiado grande: diverge y no se da por convergido
+    katzOptions.alpha = 10.0;
+    EXPECT_FALSE(Algorithms::KatzCentrality(csr, reverse, katzOptions).converged);
+}
+
+// ---------- TEST orden de vértices ----------
+TEST(AlgorithmsTest, VertexOrdersKeepResults) {
+    for (bool directed : {false, true}) {
+        CsrGraph<int> csr(randomSparseGraph(3000, 9000, directed, 11));
+        auto bfs = Algorithms::BFS(csr, 0);
+        auto sssp = Algorithms::Dijkstra(csr, 0);
+        for (VertexOrder order : {VertexOrder::Degree, VertexOrder::Rcm, VertexOrder::Rabbit}) {
+            auto reordered = Algorithms::Reorder(csr, order);
+            // mismos IDs y aristas en otro orden
+            auto ids = reordered.vertexIndex().ids();
+            EXPECT_NE(ids, csr.vertexIndex().ids()) << vertexOrderName(order);
+            std::sort(ids.begin(), ids.end());
+            EXPECT_EQ(ids, csr.vertexIndex().ids()) << vertexOrderName(order);
+            EXPECT_EQ(reordered.edgeCount(), csr.edgeCount());
+            // los resultados, leídos por ID, no cambian
+            EXPECT_EQ(Algorithms::BFS(reordered, 0).depth, bfs.depth) << vertexOrderName(order);
+            EXPECT_EQ(Algorithms::Dijkstra(reordered, 0).dist, sssp.dist) << vertexOrderName(order);
+        }
+    }
+
+    // mayor distancia entre los índices de los extremos de una arista
+    auto bandwidth = [](const CsrGraph<int>& g) {
+        int widest = 0;
+        for (int u = 0; u < static_cast<int>(g.vertexCount()); ++u)
+            for (int v : g.neighbors(u)) widest = std::max(widest, std::abs(u - v));
+        return widest;
+    };
+    std::mt19937 gen(3);
+
+    // malla 60x60 con IDs barajados: RCM la deja con un ancho de banda del orden del lado
+    const int side = 60;
+    std::vector<int> id(side * side);
+    std::iota(id.begin(), id.end(), 0);
+    std::shuffle(id.begin(), id.end(), gen);
+    AdjacencyListGraph<int> grid(false);
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            if (c + 1 < side) grid.addEdge(id[r * side + c], id[r * side + c + 1], 1);
+            if (r + 1 < side) grid.addEdge(id[r * side + c], id[(r + 1) * side + c], 1);
+        }
+    }
+    CsrGraph<int> shuffled(grid);
+    EXPECT_GT(bandwidth(shuffled), 1000);
+    EXPECT_LE(bandwidth(Algorithms::Reorder(shuffled, VertexOrder::Rcm)), 2 * side);
+
+    // cuatro cliques de 10 unidas en anillo, IDs barajados: Rabbit deja cada una contigua
+    std::vector<int> member(40);
+    std::iota(member.begin(), member.end(), 0);
+    std::shuffle(member.begin(), member.end(), gen);
+    AdjacencyListGraph<int> cliques(false);
+    for (int k = 0; k < 4; ++k) {
+        for (int i = 0; i < 10; ++i)
+            for (int j = i + 1; j < 10; ++j) cliques.addEdge(member[k * 10 + i], member[k * 10 + j], 1);
+        cliques.addEdge(member[k * 10], member[(k + 1) % 4 * 10 + 1], 1);
+    }
+    auto rabbit = Algorithms::Reorder(CsrGraph<int>(cliques), VertexOrder::Rabbit);
+    for (int k = 0; k < 4; ++k) {
+        int first = 40, last = -1;
+        for (int i = 0; i < 10; ++i) {
+            first = std::min(first, rabbit.indexOf(member[k * 10 + i]));
+            last = std::max(last, rabbit.indexOf(member[k * 10 + i]));
+        }
+        EXPECT_EQ(last - first, 9) << "clique " << k;
+    }
+}
+
+// ---------- TEST delta-stepping ----------
+TEST(AlgorithmsTest, DeltaSteppingMatchesDijkstra) {
+    CsrGraph<int> csr(randomSparseGraph(3000, 12000, true, 11));
+    auto expected = Algorithms::Dijkstra(csr, 0);
+
+    // pesos en [1, 10]: un delta pedido se acota a ese rango
+    EXPECT_EQ(Algorithms::ResolveDelta(csr, 0.25), 1.0);
+    EXPECT_EQ(Algorithms::ResolveDelta(csr, 4.5), 4.0);
+    EXPECT_EQ(Algorithms::ResolveDelta(csr, 1e300), 10.0);
+    EXPECT_EQ(Algorithms::ResolveDelta(csr, -1.0), Algorithms::AutoDelta(csr));
+
+    for (double delta : {0.0, 1.0, 4.0, 50.0, 1e300}) {
+        Algorithms::DeltaSteppingOptions options;
+        options.delta = delta;
+        options.threads = 4;
+        auto r = Algorithms::DeltaStepping(csr, 0, options);
+        EXPECT_EQ(r.dist, expected.dist);
+
+        // cada padre está sobre un camino mínimo
+        for (const auto& [v, p] : r.parent) {
+            if (p == -1) continue;
+            int u = csr.indexOf(p);
+            auto nbrs = csr.neighbors(u);
+            auto wts = csr.weights(u);
+            bool tight = false;
+            for (size_t k = 0; k < nbrs.size(); ++k)
+                tight |= csr.vertexId(nbrs[k]) == v && r.dist.at(p) + wts[k] == r.dist.at(v);
+            EXPECT_TRUE(tight);
+        }
+    }
+}
+
+TEST(AlgorithmsTest, DeltaSteppingWideWeightRange) {
+    // delta pequeño con pesos de 1 a 1e8: los cubos forman un anillo acotado y delta no
+    // baja de peso máximo / maxBuckets, en vez de reservar un cubo por cada unidad de distancia
+    AdjacencyListGraph<int> g(true);
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> node(0, 999);
+    for (int i = 0; i < 999; ++i) g.addEdge(i, i + 1, 100000000);
+    for (int i = 0; i < 4000; ++i) g.addEdge(node(gen), node(gen), gen() % 2 ? 1 : 100000000);
+    CsrGraph<int> csr(g);
+    EXPECT_EQ(Algorithms::ResolveDelta(csr, 1.0), 24415.0); // ceil(1e8 / 4096)
+
+    Algorithms::DeltaSteppingOptions options;
+    options.delta = 1;
+    options.threads = 4;
+    EXPECT_EQ(Algorithms::DeltaStepping(csr, 0, options).dist, Algorithms::Dijkstra(csr, 0).dist);
+
+    // con pesos double, distancia / delta sigue cabiendo en el índice de cubo
+    AdjacencyListGraph<double> wide(true);
+    for (int i = 0; i < 200; ++i) {
+        wide.addEdge(i, i + 1, 1e150);
+        wide.addEdge(i, (i * 7 + 3) % 201, 1e-150);
+    }
+    options.delta = 1e-150;
+    EXPECT_EQ(Algorithms::DeltaStepping(wide, 0, options).dist, Algorithms::Dijkstra(wide, 0).dist);
+}
+
+TEST(AlgorithmsTest, DeltaSteppingDoubleWeights) {
+    AdjacencyListGraph<double> g;
+    g.addEdge(0, 1, 4.0);
+    g.addEdge(0, 2, 1.0);
+    g.addEdge(2, 1, 2.0);
+    g.addEdge(1, 3, 1.0);
+    g.addEdge(2, 3, 5.0);
+
+    auto r = Algorithms::DeltaStepping(g, 0);
+    auto expected = Algorithms::Dijkstra(g, 0);
+    EXPECT_EQ(r.dist, expected.dist);
+    EXPECT_EQ(r.parent, expected.parent);
+}
+
+// ---------- TEST SSSP incremental ----------
+TEST(AlgorithmsTest, DynamicShortestPathsMatchesDijkstra) {
+    for (bool directed : {true, false}) {
+        auto g = randomSparseGraph(2000, 6000, directed, 17);
+        DynamicShortestPaths<int> paths(CsrGraph<int>(g), 0);
+        EXPECT_EQ(paths.result().dist, Algorithms::Dijkstra(g, 0).dist);
+
+        std::mt19937 gen(23);
+        std::uniform_int_distribution<int> node(0, 2009), weight(1, 10), op(0, 2);
+        for (int batch = 0; batch < 40; ++batch) {
+            // lotes de inserciones, borrados y cambios de peso sobre aristas existentes
+            std::vector<EdgeChange<int>> changes;
+            for (int k = 0; k < 8; ++k) {
+                EdgeChange<int> c{EdgeChange<int>::Kind::Insert, node(gen), node(gen), weight(gen)};
+                const auto& adj = g.getAdjList();
+                auto it = adj.find(c.from);
+                if (op(gen) > 0 && it != adj.end() && !it->second.empty()) {
+                    c.to = it->second[gen() % it->second.size()].first;
+                    c.kind = op(gen) == 0 ? EdgeChange<int>::Kind::Remove : EdgeChange<int>::Kind::SetWeight;
+                }
+                applyEdgeChanges<int>(g, std::span(&c, 1));
+                changes.push_back(c);
+            }
+            paths.apply(std::span<const EdgeChange<int>>(changes));
+            ASSERT_EQ(paths.result().dist, Algorithms::Dijkstra(g, 0).dist) << "batch " << batch;
+        }
+    }
+}
+
+// ---------- TEST política de traza ----------
+TEST(AlgorithmsTest, CountingTraceDijkstra) {
+    AdjacencyListGraph<double> g;
+    g.addEdge(0, 1, 4.0);
+    g.addEdge(0, 2, 1.0);
+    g.addEdge(2, 1, 2.0);
+    g.addEdge(1, 3, 1.0);
+    g.addEdge(2, 3, 5.0);
+
+    CountingTrace trace;
+    auto r = Algorithms::Dijkstra(g, 0, trace);
+    EXPECT_DOUBLE_EQ(r.dist.at(3), 4.0);
+
+    EXPECT_EQ(trace.verticesSettled, 4);
+    EXPECT_EQ(trace.edgesRelaxed, 10); // grafo no dirigido: 5 aristas en cada sentido
+    EXPECT_EQ(trace.heapPushes, trace.verticesSettled + trace.stalePops);
+    EXPECT_GT(trace.stalePops, 0);     // 1 entra con dist 4 y luego mejora a 3
+
+    // la traza por defecto no ocupa espacio ni cambia el resultado
+    static_assert(std::is_empty_v<NullTrace>);
+    EXPECT_EQ(Algorithms::Dijkstra(g, 0).dist, r.dist);
+}
+
+// ---------- TEST colas de prioridad ----------
+TEST(AlgorithmsTest, MonotoneQueuesPopInOrder) {
+    static_assert(std::is_same_v<MonotoneQueue<int>, RadixHeap<int>>);
+    static_assert(std::is_same_v<MonotoneQueue<double>, DaryHeap<double>>);
+
+    // carga como la de Dijkstra: cada clave insertada es la última sacada más un peso
+    auto check = [](auto queue, auto maxWeight) {
+        using Key = decltype(maxWeight);
+        std::mt19937 gen(5);
+        std::uniform_int_distribution<int> pushes(0, 3);
+        std::multiset<Key> expected;
+        Key last = 0;
+        for (int round = 0; round < 20000; ++round) {
+            for (int k = pushes(gen); k > 0; --k) {
+                const Key key = last + static_cast<Key>(gen() % 1000) * maxWeight / 1000;
+                queue.push(key, round);
+                expected.insert(key);
+            }
+            if (queue.empty()) continue;
+            const auto [key, value] = queue.pop();
+            ASSERT_EQ(key, *expected.begin());
+            expected.erase(expected.begin());
+            last = key;
+        }
+        EXPECT_EQ(queue.size(), expected.size());
+    };
+    check(RadixHeap<int>(), 10);
+    check(RadixHeap<long long>(), 1LL << 40);
+    check(DaryHeap<double>(), 7.5);
+    check(DaryHeap<int>(), 10);
+}
+
+// ---------- TEST reparto de hilos ----------
+TEST(AlgorithmsTest, ThreadsForClampsRequests) {
+    const unsigned hardware = Parallel::defaultThreads();
+    EXPECT_EQ(Parallel::threadsFor(1 << 20, 1u << 20), hardware);
+    EXPECT_EQ(Parallel::threadsFor(10, 1), 1u);
+    EXPECT_EQ(Parallel::threadsFor(10, 0), 1u);
+
+    std::atomic<unsigned> ran{0};
+    Parallel::run(hardware, [&](unsigned) { ++ran; });
+    EXPECT_EQ(ran.load(), hardware);
+}
+
+TEST(AlgorithmsTest, ParallelRunRethrowsWorkerErrors) {
+    // la excepción de un hilo de trabajo llega al llamante, después de que todos terminen
+    std::atomic<unsigned> finished{0};
+    EXPECT_THROW(Parallel::run(4, [&](unsigned tid) {
+        if (tid == 2) throw std::runtime_error("worker");
+        ++finished;
+    }), std::runtime_error);
+    EXPECT_EQ(finished.load(), 3u);
+}
+
+// ---------- TEST Dijkstra bidireccional y A* ----------
+TEST(AlgorithmsTest, BidirectionalMatchesDijkstra) {
+    for (bool directed : {false, true}) {
+        CsrGraph<int> csr(randomSparseGraph(500, 1500, directed, 3));
+        auto reverse = csr.transposed();
+        auto full = Algorithms::Dijkstra(csr, 0);
+
+        for (int target = 0; target < 500; target += 7) {
+            auto r = Algorithms::BidirectionalSearch(csr, reverse, 0, target);
+            bool reachable = full.dist.at(target) != std::numeric_limits<int>::max();
+            ASSERT_EQ(r.found, reachable) << "target " << target;
+            if (!reachable) continue;
+            EXPECT_EQ(r.cost, full.dist.at(target));
+            ASSERT_FALSE(r.path.empty());
+            EXPECT_EQ(r.path.front(), 0);
+            EXPECT_EQ(r.path.back(), target);
+        }
+    }
+}
+
+TEST(AlgorithmsTest, ContractionHierarchyMatchesDijkstra) {
+    for (bool directed : {false, true}) {
+        auto g = randomSparseGraph(400, 1200, directed, 5);
+        CsrGraph<int> csr(g);
+        auto ch = ContractionHierarchy<int>::build(csr, 7);
+        EXPECT_EQ(ch.graphVersion(), 7u);
+
+        for (int source : {0, 13, 211}) {
+            auto full = Algorithms::Dijkstra(csr, source);
+            for (int target = 0; target < 400; target += 3) {
+                auto r = ch.query(source, target);
+                bool reachable = full.dist.at(target) != std::numeric_limits<int>::max();
+                ASSERT_EQ(r.found, reachable) << source << " -> " << target;
+                if (!reachable) continue;
+                EXPECT_EQ(r.cost, full.dist.at(target));
+
+                // el camino desempaquetado usa aristas originales y suma el coste
+                ASSERT_EQ(r.path.front(), source);
+                ASSERT_EQ(r.path.back(), target);
+                int length = 0;
+                for (size_t i = 0; i + 1 < r.path.size(); ++i) {
+                    const auto& edges = g.getAdjList().at(r.path[i]);
+                    int best = std::numeric_limits<int>::max();
+                    for (const auto& [to, w] : edges)
+                        if (to == r.path[i + 1]) best = std::min(best, w);
+                    ASSERT_NE(best, std::numeric_limits<int>::max());
+                    length += best;
+                }
+                EXPECT_EQ(length, r.cost);
+            }
+        }
+    }
+}
+
+TEST(AlgorithmsTest, FloydWarshallMatchesDijkstra) {
+    for (bool directed : {false, true}) {
+        // 150 nodos con bloques de 32: el último bloque queda incompleto
+        auto matrix = GraphGenerator::generateAdjacencyMatrixGraph<int>(150, 0.03, 1, 10, directed, 11);
+        AdjacencyListGraph<int> list(directed);
+        for (size_t i = 0; i < matrix.size(); ++i) {
+            list.addNode(static_cast<int>(i));
+            matrix.forEachNeighbor(i, [&](size_t j, int w) {
+                if (directed || i < j) list.addEdge(static_cast<int>(i), static_cast<int>(j), w);
+            });
+        }
+        CsrGraph<int> csr(list);
+
+        Algorithms::FloydWarshallOptions options;
+        options.tileSize = 32;
+        options.threads = 3;
+        auto apsp = Algorithms::FloydWarshall(matrix, options);
+        EXPECT_FALSE(apsp.negativeCycle);
+
+        for (int source = 0; source < 150; source += 17) {
+            auto single = Algorithms::Dijkstra(csr, source);
+            for (int target = 0; target < 150; ++target) {
+                ASSERT_EQ(apsp.at(source, target), single.dist.at(target)) << source << " -> " << target;
+            }
+        }
+
+        // serialización: null para los pares sin camino
+        auto back = GraphAPI::deserializeAllPairs<int>(GraphAPI::serialize(apsp));
+        EXPECT_EQ(back.dist, apsp.dist);
+    }
+}
+
+// Traza que pide cancelar a partir de la consulta número `after`, desde cualquier hilo
+struct CancelAfterPolls : NullTrace {
+    explicit CancelAfterPolls(int after) : after(after) {}
+    bool cancelRequested() const noexcept { return polls.fetch_add(1) + 1 >= after; }
+    int after;
+    mutable std::atomic<int> polls{0};
+};
+
+TEST(AlgorithmsTest, ParallelAlgorithmsStopWhenCancelled) {
+    // Floyd-Warshall: 32 rondas de 3 barreras; se para al final de la ronda en que se pide
+    auto matrix = GraphGenerator::generateAdjacencyMatrixGraph<int>(256, 0.05, 1, 10, true, 5);
+    Algorithms::FloydWarshallOptions fwOptions;
+    fwOptions.tileSize = 8;
+    fwOptions.threads = 4;
+    CancelAfterPolls fwTrace(4);
+    EXPECT_THROW(Algorithms::FloydWarshall(matrix, fwOptions, fwTrace), OperationCancelled);
+    EXPECT_EQ(fwTrace.polls.load(), 6);
+
+    // delta-stepping: se para en la siguiente elección de cubo
+    CsrGraph<int> csr(randomSparseGraph(3000, 12000, true, 11));
+    Algorithms::DeltaSteppingOptions dsOptions;
+    dsOptions.delta = 1;
+    dsOptions.threads = 4;
+    CancelAfterPolls dsTrace(3);
+    EXPECT_THROW(Algorithms::DeltaStepping(csr, 0, dsOptions, dsTrace), OperationCancelled);
+    EXPECT_EQ(dsTrace.polls.load(), 3);
+
+    // sin cancelación, el resultado no cambia
+    CancelAfterPolls never(std::numeric_limits<int>::max());
+    EXPECT_EQ(Algorithms::DeltaStepping(csr, 0, dsOptions, never).dist, Algorithms::Dijkstra(csr, 0).dist);
+}
+
+TEST(AlgorithmsTest, FloydWarshallNegativeWeights) {
+    AdjacencyMatrixGraph<double> g(3, true);
+    g.addEdge(0, 1, 4.0);
+    g.addEdge(1, 2, -2.0);
+    g.addEdge(0, 2, 3.0);
+
+    auto r = Algorithms::FloydWarshall(g);
+    EXPECT_FALSE(r.negativeCycle);
+    EXPECT_DOUBLE_EQ(r.at(0, 2), 2.0);
+    EXPECT_EQ(r.at(2, 0), AllPairsResult<double>::infinity);
+
+    g.addEdge(2, 1, 1.0); // ciclo 1 -> 2 -> 1 de coste -1
+    EXPECT_TRUE(Algorithms::FloydWarshall(g).negativeCycle);
+}
+
+TEST(AlgorithmsTest, AStarOnGrid) {
+    // rejilla 20x20 con pesos >= distancia euclídea entre extremos
+    const int side = 20;
+    AdjacencyListGraph<double> g(false);
+    NodeCoordinates coords;
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> extra(0.0, 2.0);
+    for (int i = 0; i < side * side; ++i) {
+        g.addNode(i);
+        coords.x.push_back(i % side);
+        coords.y.push_back(i / side);
+    }
+    for (int i = 0; i < side * side; ++i) {
+        if (i % side + 1 < side) g.addEdge(i, i + 1, 1.0 + extra(gen));
+        if (i + side < side * side) g.addEdge(i, i + side, 1.0 + extra(gen));
+    }
+    CsrGraph<double> csr(g);
+
+    auto full = Algorithms::Dijkstra(csr, 0);
+    CountingTrace plain, astar;
+    auto r1 = Algorithms::BidirectionalSearch(csr, csr, 0, side * side - 1, NoHeuristic{}, plain);
+    auto r2 = Algorithms::BidirectionalSearch(csr, csr, 0, side * side - 1, EuclideanHeuristic{&coords}, astar);
+
+    EXPECT_DOUBLE_EQ(r1.cost, full.dist.at(side * side - 1));
+    EXPECT_NEAR(r2.cost, r1.cost, 1e-9);
+    EXPECT_LE(astar.verticesSettled, plain.verticesSettled);
+    EXPECT_LT(plain.verticesSettled, static_cast<uint64_t>(side * side)); // parada temprana
+}
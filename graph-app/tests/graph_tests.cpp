@@ -1,7 +1,23 @@
 #include "graph_core/GraphGenerator.hpp"
 #include "graph_core/GraphStorage.hpp"
+#include "graph_core/CsrGraph.hpp"
+#include "graph_repository/GraphRepository.hpp"
+#include "graph_repository/ResultCache.hpp"
+#include "jobs/JobManager.hpp"
+#include "metrics/Metrics.hpp"
 #include "api/GraphAPI.hpp"
+#include "api/GraphUpload.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <thread>
 
 TEST(GraphListTest, AddNodesAndEdges) {
     // Undirected graph
@@ -30,6 +46,74 @@ TEST(GraphMatrixTest, AddNodesAndEdges) {
     EXPECT_EQ(mat[1][0].value(), 7); // no dirigido
 }
 
+TEST(GraphMatrixTest, PresenceBitmapNeighbors) {
+    // 130 nodos: cada fila ocupa tres palabras del bitmap
+    AdjacencyMatrixGraph<double> graph(130, true);
+    graph.addEdge(5, 0, 1.5);
+    graph.addEdge(5, 63, 2.5);
+    graph.addEdge(5, 64, 0.0);
+    graph.addEdge(5, 129, 4.0);
+    graph.addEdge(7, 5, 9.0);
+
+    EXPECT_EQ(graph.rowWords(), 3u);
+    EXPECT_EQ(graph.degree(5), 4u);
+    EXPECT_EQ(graph.degree(6), 0u);
+    EXPECT_EQ(graph.edgeCount(), 5u);
+
+    // peso 0 es una arista; la ausencia se distingue por el bitmap
+    EXPECT_TRUE(graph.hasEdge(5, 64));
+    EXPECT_EQ(graph.edgeWeight(5, 64), std::optional<double>(0.0));
+    EXPECT_FALSE(graph.edgeWeight(5, 65).has_value());
+    EXPECT_FALSE(graph.getMatrix()[5][5].has_value());
+
+    std::vector<std::pair<size_t, double>> seen;
+    graph.forEachNeighbor(5, [&](size_t j, double w) { seen.emplace_back(j, w); });
+    std::vector<std::pair<size_t, double>> expected{{0, 1.5}, {63, 2.5}, {64, 0.0}, {129, 4.0}};
+    EXPECT_EQ(seen, expected);
+}
+
+TEST(CsrGraphTest, BuildFromAdjacencyList) {
+    AdjacencyListGraph<int> graph(true);
+    graph.addNode(10);
+    graph.addNode(20);
+    graph.addEdge(10, 20, 5);
+    graph.addEdge(10, 30, 2); // 30 solo aparece como destino
+
+    CsrGraph<int> csr(graph);
+    EXPECT_EQ(csr.vertexCount(), 3);
+    EXPECT_EQ(csr.edgeCount(), 2);
+
+    int u = csr.indexOf(10);
+    ASSERT_GE(u, 0);
+    ASSERT_EQ(csr.neighbors(u).size(), 2);
+    EXPECT_EQ(csr.vertexId(csr.neighbors(u)[0]), 20);
+    EXPECT_EQ(csr.weights(u)[0], 5);
+    EXPECT_EQ(csr.vertexId(csr.neighbors(u)[1]), 30);
+    EXPECT_EQ(csr.weights(u)[1], 2);
+    EXPECT_EQ(csr.neighbors(csr.indexOf(30)).size(), 0);
+    EXPECT_EQ(csr.indexOf(99), -1);
+}
+
+TEST(VertexMapTest, TranslatesExternalIds) {
+    auto index = std::make_shared<const VertexIndex>(std::vector<int>{7, 42, 100});
+    VertexMap<int> depth(index, -1);
+    depth.at(42) = 3;
+    depth.dense()[2] = 5;
+
+    EXPECT_EQ(depth.size(), 3);
+    EXPECT_EQ(depth.at(42), 3);
+    EXPECT_EQ(depth.at(100), 5);
+    EXPECT_EQ(depth.count(8), 0);
+    EXPECT_EQ(depth.find(8), depth.end());
+    EXPECT_THROW(depth.at(8), std::out_of_range);
+
+    // igualdad por ID aunque el orden denso sea distinto
+    auto other = std::make_shared<const VertexIndex>(std::vector<int>{100, 42, 7});
+    VertexMap<int> copy(other, -1);
+    for (const auto& [id, d] : depth) copy.at(id) = d;
+    EXPECT_EQ(copy, depth);
+}
+
 TEST(GraphGeneratorTest, GenerateRandomGraph) {
     auto graph = GraphGenerator::generateAdjacencyListGraph<int>(5, 1.0, 1, 10, false);
     EXPECT_EQ(graph.getAdjList().size(), 5);
@@ -44,6 +128,217 @@ TEST(GraphGeneratorTest, GenerateRandomGraph) {
     EXPECT_TRUE(has_edges);
 }
 
+TEST(GraphGeneratorTest, SeedIsReproducible) {
+    // misma semilla con distinto número de hilos -> mismas aristas
+    auto a = GraphGenerator::generateErdosRenyiEdges<int>(3000, 0.002, 1, 10, true, 42, 1);
+    auto b = GraphGenerator::generateErdosRenyiEdges<int>(3000, 0.002, 1, 10, true, 42, 4);
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t k = 0; k < a.size(); ++k) {
+        EXPECT_EQ(a[k].from, b[k].from);
+        EXPECT_EQ(a[k].to, b[k].to);
+        EXPECT_EQ(a[k].weight, b[k].weight);
+    }
+    auto c = GraphGenerator::generateErdosRenyiEdges<int>(3000, 0.002, 1, 10, true, 43, 4);
+    bool same = a.size() == c.size() && std::equal(a.begin(), a.end(), c.begin(),
+        [](const auto& x, const auto& y) { return x.from == y.from && x.to == y.to; });
+    EXPECT_FALSE(same);
+}
+
+TEST(GraphGeneratorTest, SkipSamplingEdgeCount) {
+    for (bool directed : {false, true}) {
+        const size_t n = 4000;
+        const double p = 0.005;
+        auto edges = GraphGenerator::generateErdosRenyiEdges<double>(n, p, 0.5, 2.0, directed, 7);
+
+        // pares válidos, sin repetir y sin bucles
+        std::set<std::pair<int, int>> seen;
+        for (const auto& e : edges) {
+            ASSERT_NE(e.from, e.to);
+            if (!directed) {
+                ASSERT_LT(e.from, e.to);
+            }
+            ASSERT_TRUE(seen.insert({e.from, e.to}).second);
+            ASSERT_GE(e.weight, 0.5);
+            ASSERT_LE(e.weight, 2.0);
+        }
+
+        // número de aristas dentro de 5 desviaciones típicas de la media binomial
+        double pairs = directed ? double(n) * (n - 1) : double(n) * (n - 1) / 2;
+        double mean = pairs * p, sigma = std::sqrt(pairs * p * (1 - p));
+        EXPECT_NEAR(double(edges.size()), mean, 5 * sigma);
+    }
+}
+
+TEST(GraphRepositoryTest, SnapshotSurvivesNewVersion) {
+    GraphRepository repo;
+    AdjacencyListGraph<int> g1(true);
+    g1.addEdge(0, 1, 5);
+    int id = repo.addGraph(std::move(g1));
+
+    // una lectura en curso conserva su versión aunque se publique otra
+    auto before = repo.snapshot(id);
+    AdjacencyListGraph<int> g2(true);
+    g2.addEdge(0, 1, 5);
+    g2.addEdge(1, 2, 3);
+    EXPECT_EQ(repo.updateGraph(id, std::move(g2)), 1u);
+
+    auto after = repo.snapshot(id);
+    EXPECT_EQ(before->version(), 0u);
+    EXPECT_EQ(after->version(), 1u);
+    EXPECT_EQ(before->csr<int>().vertexCount(), 2u);
+    EXPECT_EQ(after->csr<int>().vertexCount(), 3u);
+    EXPECT_EQ(after->reverseCsr<int>().degree(after->csr<int>().indexOf(2)), 1u);
+
+    EXPECT_TRUE(after->holds<AdjacencyListGraph<int>>());
+    EXPECT_THROW(after->graph<AdjacencyMatrixGraph<int>>(), std::runtime_error);
+    EXPECT_THROW(repo.snapshot(id + 1), std::runtime_error);
+}
+
+TEST(GraphRepositoryTest, ConcurrentAddAndRead) {
+    GraphRepository repo;
+    const int perThread = 50;
+    std::vector<std::jthread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&] {
+            for (int k = 0; k < perThread; ++k) {
+                AdjacencyListGraph<int> g(false);
+                g.addEdge(0, 1, k);
+                int id = repo.addGraph(std::move(g));
+                // lectores concurrentes sobre el grafo recién publicado
+                EXPECT_EQ(repo.getCsrGraph<int>(id)->edgeCount(), 2u);
+            }
+        });
+    }
+    writers.clear();
+
+    // ids únicos
+    auto ids = repo.ids();
+    std::set<int> unique(ids.begin(), ids.end());
+    EXPECT_EQ(unique.size(), 4u * perThread);
+}
+
+TEST(ResultCacheTest, HitsEvictsAndInvalidates) {
+    ResultCache cache(8 * 4096);
+    const std::string body(1000, 'x');
+
+    EXPECT_EQ(cache.find(0, 1, "bfs", 0), nullptr);
+    cache.store(0, 1, "bfs", 0, body);
+    ASSERT_NE(cache.find(0, 1, "bfs", 0), nullptr);
+    EXPECT_EQ(*cache.find(0, 1, "bfs", 0), body);
+    EXPECT_EQ(cache.find(0, 1, "bfs", 1), nullptr);
+    EXPECT_EQ(cache.find(0, 1, "dfs", 0), nullptr);
+
+    // una versión nueva descarta las entradas de la anterior
+    EXPECT_EQ(cache.find(0, 2, "bfs", 0), nullptr);
+    cache.store(0, 1, "bfs", 0, body); // versión ya superada: no se guarda
+    EXPECT_EQ(cache.stats().entries, 0u);
+
+    // LRU: al llenarse sale la entrada usada hace más tiempo
+    for (int source = 0; source < 64; ++source) {
+        cache.store(1, 0, "dijkstra", source, body);
+        ASSERT_NE(cache.find(1, 0, "dijkstra", 0), nullptr);
+    }
+    EXPECT_LE(cache.stats().bytes, cache.capacityBytes());
+    EXPECT_GT(cache.stats().evictions, 0u);
+    EXPECT_NE(cache.find(1, 0, "dijkstra", 0), nullptr);
+    EXPECT_EQ(cache.find(1, 0, "dijkstra", 1), nullptr);
+
+    // demasiado grande para la caché
+    cache.store(2, 0, "bfs", 0, std::string(cache.capacityBytes(), 'y'));
+    EXPECT_EQ(cache.find(2, 0, "bfs", 0), nullptr);
+
+    cache.invalidate(1);
+    EXPECT_EQ(cache.stats().entries, 0u);
+    EXPECT_EQ(cache.stats().bytes, 0u);
+}
+
+TEST(WorkStealingPoolTest, RunsEveryTask) {
+    std::atomic<int> done{0};
+    {
+        WorkStealingPool pool(4);
+        for (int i = 0; i < 1000; ++i) {
+            // tareas que a su vez encolan otra en la cola de su hilo
+            pool.submit([&pool, &done] {
+                pool.submit([&done] { done.fetch_add(1); });
+                done.fetch_add(1);
+            });
+        }
+    } // el destructor termina lo pendiente
+    EXPECT_EQ(done.load(), 2000);
+}
+
+TEST(JobManagerTest, PerGraphLimitAndCancellation) {
+    using State = JobManager::State;
+    JobManager jobs(4, 1);
+    auto waitFor = [&](std::uint64_t id, State state) {
+        for (int i = 0; i < 2000 && jobs.find(id)->state != state; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return jobs.find(id)->state;
+    };
+
+    // un trabajo que no termina hasta que se cancela: la traza lanza OperationCancelled
+    auto blocking = jobs.submit(0, "bfs", [](const std::atomic<bool>& cancelled) {
+        CancellableTrace<> trace(cancelled);
+        for (;;) {
+            trace.phaseBegin(TracePhase::Search);
+            std::this_thread::yield();
+        }
+        return JobManager::Outcome{};
+    });
+    auto queued = jobs.submit(0, "dfs", [](const std::atomic<bool>&) { return JobManager::Outcome{200, "dfs"}; });
+    auto other = jobs.submit(1, "bfs", [](const std::atomic<bool>&) { return JobManager::Outcome{200, "other"}; });
+    auto failing = jobs.submit(2, "dijkstra", [](const std::atomic<bool>&) -> JobManager::Outcome {
+        throw std::runtime_error("boom");
+    });
+
+    EXPECT_EQ(waitFor(blocking, State::Running), State::Running);
+    EXPECT_EQ(waitFor(other, State::Done), State::Done);
+    EXPECT_EQ(*jobs.find(other)->result, "other");
+    EXPECT_EQ(waitFor(failing, State::Failed), State::Failed);
+    EXPECT_EQ(jobs.find(failing)->status, 500);
+
+    // límite de 1 por grafo: el segundo trabajo del grafo 0 espera al primero
+    EXPECT_EQ(jobs.find(queued)->state, State::Queued);
+    EXPECT_TRUE(jobs.cancel(blocking));
+    EXPECT_EQ(waitFor(blocking, State::Cancelled), State::Cancelled);
+    EXPECT_EQ(waitFor(queued, State::Done), State::Done);
+    EXPECT_EQ(*jobs.find(queued)->result, "dfs");
+
+    EXPECT_FALSE(jobs.cancel(12345));
+    EXPECT_FALSE(jobs.find(12345));
+}
+
+TEST(JobManagerTest, RetentionDropsOldestFirst) {
+    using State = JobManager::State;
+    JobManager jobs(1, 1, 3, 100);
+    auto finished = [&](std::size_t size) {
+        auto id = jobs.submit(0, "bfs", [size](const std::atomic<bool>&) {
+            return JobManager::Outcome{200, std::string(size, 'x')};
+        });
+        for (int i = 0; i < 2000 && (!jobs.find(id) || jobs.find(id)->state != State::Done); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return id;
+    };
+
+    // límite de trabajos: 3
+    auto a = finished(10), b = finished(10), c = finished(10), d = finished(10);
+    EXPECT_FALSE(jobs.find(a));
+    EXPECT_TRUE(jobs.find(b) && jobs.find(c) && jobs.find(d));
+    EXPECT_EQ(jobs.resultBytes(), 30u);
+
+    // límite de bytes: 100; se van los más antiguos hasta caber
+    auto e = finished(80);
+    EXPECT_FALSE(jobs.find(b));
+    EXPECT_TRUE(jobs.find(c) && jobs.find(d) && jobs.find(e));
+    EXPECT_EQ(jobs.resultBytes(), 100u);
+
+    // el último se conserva aunque no quepa solo
+    auto f = finished(500);
+    EXPECT_FALSE(jobs.find(c) || jobs.find(d) || jobs.find(e));
+    EXPECT_EQ(jobs.find(f)->result->size(), 500u);
+    EXPECT_EQ(jobs.resultBytes(), 500u);
+}
+
 TEST(GraphAPITest, SerializeDeserializeList) {
     AdjacencyListGraph<int> graph(false);
     graph.addNode(0, "A");
@@ -68,4 +363,287 @@ TEST(GraphAPITest, SerializeDeserializeMatrix) {
 
     EXPECT_EQ(newGraph.getMatrix()[0][1].value(), 4);
     EXPECT_EQ(newGraph.getMatrix()[1][0].value(), 4);
-}
\ No newline at end of file
+}
+TEST(GraphAPITest, StreamingWriterMatchesSerialize) {
+    AdjacencyListGraph<int> graph(true);
+    graph.addNode(0, "A \"quoted\"\n");
+    graph.addNode(1, "B");
+    graph.addEdge(0, 1, 3);
+    graph.addEdge(1, 2, 5);
+
+    auto toJson = [](const auto& value) {
+        std::string out;
+        JsonWriter w(out);
+        GraphAPI::write(w, value);
+        return nlohmann::json::parse(out);
+    };
+
+    EXPECT_EQ(toJson(graph), GraphAPI::serialize(graph));
+
+    // resultados con distancias infinitas (null) y en coma flotante
+    CsrGraph<int> csr(graph);
+    EXPECT_EQ(toJson(Algorithms::Dijkstra(csr, 1)), GraphAPI::serialize(Algorithms::Dijkstra(csr, 1)));
+    EXPECT_EQ(toJson(Algorithms::BFS(csr, 0)), GraphAPI::serialize(Algorithms::BFS(csr, 0)));
+
+    AdjacencyMatrixGraph<int> matrix(3, false);
+    matrix.addEdge(0, 1, 4);
+    EXPECT_EQ(toJson(matrix), GraphAPI::serialize(matrix));
+    EXPECT_EQ(toJson(Algorithms::FloydWarshall(matrix)), GraphAPI::serialize(Algorithms::FloydWarshall(matrix)));
+
+    std::string out;
+    JsonWriter w(out);
+    w.beginArray().value(0.5).value(2.0).value(std::numeric_limits<double>::infinity()).value("\x01").endArray();
+    EXPECT_EQ(out, "[0.5,2.0,null,\"\\u0001\"]");
+}
+
+TEST(GraphAPITest, UploadMatchesDeserialize) {
+    AdjacencyListGraph<int> graph(false);
+    graph.addNode(0, "A");
+    graph.addNode(1, "B");
+    graph.addEdge(0, 1, 3);
+    graph.addEdge(1, 2, 5);
+    graph.addEdge(2, 0, 1);
+
+    auto j = GraphAPI::serialize(graph);
+    auto upload = GraphUpload<int>::parse(j.dump());
+    EXPECT_FALSE(upload.isMatrix());
+    EXPECT_EQ(upload.edgeCount(), 3u);
+    auto uploaded = upload.buildList();
+    auto expected = GraphAPI::deserializeList<int>(j);
+    EXPECT_EQ(uploaded.getAdjList(), expected.getAdjList());
+    EXPECT_EQ(uploaded.getNodeLabels(), expected.getNodeLabels());
+
+    // miembros en cualquier orden, "size" después de las aristas y campos desconocidos ignorados
+    auto matrix = GraphUpload<int>::parse(R"({"edges":[{"weight":4,"to":1,"from":0,"extra":{"a":[1]}}],
+        "meta":{"nodes":[1,2]},"nodes":[{"label":"x","id":2}],"directed":true,"size":3,"type":"matrix"})").buildMatrix();
+    EXPECT_TRUE(matrix.isDirected());
+    EXPECT_EQ(matrix.edgeWeight(0, 1).value(), 4);
+    EXPECT_FALSE(matrix.hasEdge(1, 0));
+    EXPECT_EQ(matrix.getNodeLabels()[2], "x");
+
+    EXPECT_THROW(GraphUpload<int>::parse("[1, 2]"), std::invalid_argument);
+    EXPECT_THROW(GraphUpload<int>::parse(R"({"edges":[{"from":0}]})"), std::invalid_argument);
+    EXPECT_THROW(GraphUpload<int>::parse(R"({"edges":[{"from":0.5,"to":1}]})"), std::invalid_argument);
+    EXPECT_THROW(GraphUpload<int>::parse(R"({"type":"matrix","edges":[]})"), std::invalid_argument);
+    EXPECT_THROW(GraphUpload<int>::parse(R"({"edges":[)"), std::invalid_argument);
+    EXPECT_THROW(GraphUpload<int>::parse(R"({"type":"matrix","size":2,"edges":[{"from":0,"to":5}]})").buildMatrix(),
+                 std::invalid_argument);
+}
+
+TEST(GraphRepositoryTest, SpillsLeastRecentlyUsedOverBudget) {
+    auto makeGraph = [](int n) {
+        AdjacencyListGraph<int> g(true);
+        for (int i = 0; i + 1 < n; ++i) g.addEdge(i, i + 1, i);
+        g.addNode(0, "origen");
+        return g;
+    };
+
+    GraphRepository repo;
+    int a = repo.addGraph(makeGraph(1000));
+    int b = repo.addGraph(makeGraph(1000));
+    EXPECT_GT(repo.graphBytes(a), 0u);
+    EXPECT_EQ(repo.residentBytes(), repo.graphBytes(a) + repo.graphBytes(b));
+
+    // cabe un solo grafo: al usar a se vuelca b, el menos usado
+    repo.snapshot(a);
+    repo.setMemoryBudget(repo.graphBytes(a) + repo.graphBytes(b) / 2);
+    EXPECT_TRUE(repo.isResident(a));
+    EXPECT_FALSE(repo.isResident(b));
+    EXPECT_LE(repo.residentBytes(), repo.memoryBudget());
+
+    // una lectura de b lo recarga sin cambios y vuelca a
+    auto snap = repo.snapshot(b);
+    EXPECT_TRUE(repo.isResident(b));
+    EXPECT_FALSE(repo.isResident(a));
+    EXPECT_EQ(snap->csr<int>().vertexCount(), 1000u);
+    EXPECT_EQ(snap->csr<int>().edgeCount(), 999u);
+    EXPECT_EQ(snap->graph<AdjacencyListGraph<int>>().getNodeLabels().at(0), "origen");
+    EXPECT_EQ(repo.getCsrGraph<int>(a)->edgeCount(), 999u);
+
+    EXPECT_TRUE(repo.removeGraph(a));
+    EXPECT_THROW(repo.snapshot(a), std::runtime_error);
+}
+
+TEST(GraphRepositoryTest, SpillFormatRoundTrip) {
+    AdjacencyMatrixGraph<double> m(70, false);
+    m.addEdge(3, 65, 2.5);
+    m.addEdge(4, 4, -1.0);
+    m.addNode(3, "tres");
+    std::stringstream buffer;
+    GraphSpill::write(buffer, m);
+    auto back = GraphSpill::read<AdjacencyMatrixGraph<double>>(buffer);
+    EXPECT_EQ(back.edgeCount(), m.edgeCount());
+    EXPECT_EQ(back.edgeWeight(65, 3).value(), 2.5);
+    EXPECT_EQ(back.edgeWeight(4, 4).value(), -1.0);
+    EXPECT_EQ(back.getNodeLabels()[3], "tres");
+
+    // el tipo se comprueba al leer
+    buffer.clear();
+    buffer.seekg(0);
+    EXPECT_THROW(GraphSpill::read<AdjacencyMatrixGraph<int>>(buffer), std::runtime_error);
+}
+
+TEST(GraphRepositoryTest, SaveAllAndMapOnLoad) {
+    const auto dir = std::filesystem::temp_directory_path() / "graph_tests_save_all";
+    std::filesystem::remove_all(dir);
+
+    AdjacencyListGraph<int> list(true);
+    list.addNode(10, "diez");
+    list.addEdge(10, 20, 4);
+    list.addEdge(20, 30, 1);
+    list.addEdge(10, 30, 9);
+    AdjacencyMatrixGraph<int> matrix(3, false);
+    matrix.addEdge(0, 2, 7);
+    matrix.addNode(1, "uno");
+
+    GraphRepository repo;
+    int listId = repo.addGraph(AdjacencyListGraph<int>(list));
+    int matrixId = repo.addGraph(std::move(matrix));
+    int removedId = repo.addGraph(AdjacencyListGraph<int>(false));
+    repo.updateGraph(listId, std::move(list));
+    EXPECT_EQ(repo.saveAll(dir), 3u);
+    repo.removeGraph(removedId);
+    EXPECT_EQ(repo.saveAll(dir), 2u); // el fichero del grafo borrado desaparece
+
+    GraphRepository restored;
+    EXPECT_EQ(restored.loadAll<int>(dir), 2u);
+    auto snap = restored.snapshot(listId);
+    EXPECT_EQ(snap->version(), 1u);
+    ASSERT_TRUE(snap->holds<GraphFile::MappedGraph<int>>());
+    const auto& mapped = snap->graph<GraphFile::MappedGraph<int>>();
+    EXPECT_EQ(mapped.label(mapped.csr().indexOf(10)), "diez");
+
+    // mismos resultados sobre el grafo mapeado que sobre el original
+    auto original = repo.snapshot(listId);
+    EXPECT_EQ(Algorithms::Dijkstra(snap->csr<int>(), 10).dist, Algorithms::Dijkstra(original->csr<int>(), 10).dist);
+    EXPECT_EQ(snap->reverseCsr<int>().degree(snap->csr<int>().indexOf(30)), 2u);
+
+    const auto& m = restored.snapshot(matrixId)->graph<AdjacencyMatrixGraph<int>>();
+    EXPECT_EQ(m.edgeWeight(2, 0).value(), 7);
+    EXPECT_EQ(m.getNodeLabels()[1], "uno");
+
+    // los ids nuevos no chocan con los cargados; volver a guardar no reescribe los mapeados
+    EXPECT_GT(restored.addGraph(AdjacencyListGraph<int>(false)), matrixId);
+    EXPECT_EQ(restored.saveAll(dir), 3u);
+    EXPECT_EQ(restored.snapshot(listId)->csr<int>().edgeCount(), 3u);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(GraphRepositoryTest, LoadAllSkipsBadFiles) {
+    const auto dir = std::filesystem::temp_directory_path() / "graph_tests_bad_files";
+    std::filesystem::remove_all(dir);
+
+    AdjacencyListGraph<int> g(true);
+    g.addEdge(1, 2, 3);
+    g.addEdge(2, 3, 4);
+    GraphRepository repo;
+    int good = repo.addGraph(AdjacencyListGraph<int>(g));
+    int truncated = repo.addGraph(AdjacencyListGraph<int>(g));
+    repo.saveAll(dir);
+    const auto truncatedFile = dir / ("graph-" + std::to_string(truncated) + ".gcsr");
+    std::filesystem::resize_file(truncatedFile, std::filesystem::file_size(truncatedFile) / 2);
+    std::ofstream(dir / "graph-77.gcsr") << "not a graph";
+
+    // los ficheros dañados se apartan y el resto se carga
+    GraphRepository restored;
+    EXPECT_EQ(restored.loadAll<int>(dir), 1u);
+    EXPECT_TRUE(restored.contains(good));
+    EXPECT_FALSE(restored.contains(truncated));
+    EXPECT_FALSE(restored.contains(77));
+    EXPECT_FALSE(std::filesystem::exists(truncatedFile));
+    EXPECT_TRUE(std::filesystem::exists(dir / ("graph-" + std::to_string(truncated) + ".gcsr.bad")));
+    EXPECT_TRUE(std::filesystem::exists(dir / "graph-77.gcsr.bad"));
+
+    // guardar no los borra
+    restored.saveAll(dir);
+    EXPECT_TRUE(std::filesystem::exists(dir / "graph-77.gcsr.bad"));
+    std::filesystem::remove_all(dir);
+}
+
+TEST(GraphRepositoryTest, VertexOrderIsKept) {
+    const auto dir = std::filesystem::temp_directory_path() / "graph_tests_vertex_order";
+    std::filesystem::remove_all(dir);
+    AdjacencyListGraph<int> g(true);
+    for (int i = 0; i < 200; ++i) g.addEdge(i, (i * 37 + 11) % 200, i % 7 + 1);
+
+    GraphRepository repo;
+    int id = repo.addGraph(AdjacencyListGraph<int>(g), VertexOrder::Rcm);
+    auto snap = repo.snapshot(id);
+    EXPECT_EQ(snap->vertexOrder(), VertexOrder::Rcm);
+    const auto ids = snap->csr<int>().vertexIndex().ids();
+    EXPECT_EQ(snap->reverseCsr<int>().vertexIndex().ids(), ids);
+    auto expected = Algorithms::Dijkstra(snap->csr<int>(), 0).dist;
+    snap.reset();
+
+    // al volcarse y recargarse, y en las versiones nuevas, se reordena igual
+    int other = repo.addGraph(AdjacencyListGraph<int>(g));
+    EXPECT_EQ(repo.snapshot(other)->vertexOrder(), VertexOrder::Original);
+    repo.setMemoryBudget(1);
+    EXPECT_FALSE(repo.isResident(id));
+    EXPECT_EQ(repo.snapshot(id)->csr<int>().vertexIndex().ids(), ids);
+    repo.setMemoryBudget(0);
+    repo.updateGraph(id, AdjacencyListGraph<int>(g));
+    EXPECT_EQ(repo.snapshot(id)->csr<int>().vertexIndex().ids(), ids);
+
+    // el fichero de grafo guarda el orden
+    repo.saveAll(dir);
+    GraphRepository restored;
+    restored.loadAll<int>(dir);
+    auto mapped = restored.snapshot(id);
+    EXPECT_EQ(mapped->vertexOrder(), VertexOrder::Rcm);
+    EXPECT_EQ(mapped->csr<int>().vertexIndex().ids(), ids);
+    EXPECT_EQ(Algorithms::Dijkstra(mapped->csr<int>(), 0).dist, expected);
+    EXPECT_EQ(restored.snapshot(other)->vertexOrder(), VertexOrder::Original);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(MetricsTest, ShardedCountsAndExposition) {
+    Metrics metrics;
+    metrics.addRoute("/get_graph/<int>");
+    metrics.addAlgorithm("dijkstra");
+
+    // varios hilos registran a la vez sin perder observaciones
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&metrics, t] {
+            for (int i = 0; i < 1000; ++i)
+                metrics.observeRequest("/get_graph/<int>", t == 0 ? 404 : 200, std::chrono::microseconds(200 * t));
+        });
+    }
+    for (auto& th : threads) th.join();
+    metrics.observeRequest("/no_such_route", 404, std::chrono::milliseconds(3));
+
+    CountingTrace trace;
+    trace.verticesSettled = 10;
+    trace.edgesRelaxed = 25;
+    trace.phaseTime[1] = std::chrono::milliseconds(20);
+    metrics.observeAlgorithm("dijkstra", 7, trace);
+    metrics.observeAlgorithm("unknown", 7, trace); // no registrado: se ignora
+
+    std::string text;
+    PrometheusWriter w(text);
+    metrics.write(w);
+    auto has = [&](const std::string& line) { return text.find(line + "\n") != std::string::npos; };
+    EXPECT_TRUE(has(R"(graph_http_requests_total{route="/get_graph/<int>",code="2xx"} 7000)"));
+    EXPECT_TRUE(has(R"(graph_http_requests_total{route="/get_graph/<int>",code="4xx"} 1000)"));
+    EXPECT_TRUE(has(R"(graph_http_requests_total{route="unmatched",code="4xx"} 1)"));
+    // 0 y 200 us caben en 0.0005; 400 us también; el resto, no
+    EXPECT_TRUE(has(R"(graph_http_request_duration_seconds_bucket{route="/get_graph/<int>",le="0.0005"} 3000)"));
+    EXPECT_TRUE(has(R"(graph_http_request_duration_seconds_bucket{route="/get_graph/<int>",le="+Inf"} 8000)"));
+    EXPECT_TRUE(has(R"(graph_http_request_duration_seconds_count{route="/get_graph/<int>"} 8000)"));
+    EXPECT_TRUE(has(R"(graph_algorithm_edges_relaxed_total{algorithm="dijkstra"} 25)"));
+    EXPECT_TRUE(has(R"(graph_algorithm_duration_seconds_bucket{algorithm="dijkstra",le="0.025"} 1)"));
+    EXPECT_TRUE(has(R"(graph_graph_algorithm_runs_total{graph_id="7"} 1)"));
+    EXPECT_EQ(text.find("unknown"), std::string::npos);
+
+    // las series por grafo se limitan a los grafos guardados
+    metrics.observeAlgorithm("dijkstra", 8, trace);
+    metrics.retainGraphs({8, 9});
+    text.clear();
+    metrics.write(w);
+    EXPECT_EQ(text.find(R"(graph_id="7")"), std::string::npos);
+    EXPECT_TRUE(has(R"(graph_graph_algorithm_runs_total{graph_id="8"} 1)"));
+
+    EXPECT_EQ(MetricsMiddleware::routeOf("/jobs/42/result?x=1"), "/jobs/<int>/result");
+    EXPECT_EQ(MetricsMiddleware::routeOf("/run_algorithm"), "/run_algorithm");
+}